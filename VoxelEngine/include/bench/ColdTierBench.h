@@ -0,0 +1,9 @@
+#pragma once
+
+#include <cstddef>
+
+// Generates a world twice, moves every mixed section of one copy to the cold
+// tier and prints resident block memory before and after, the latency of
+// touching cold sections and the remesh cost through the unpack cache.
+// Returns false if the cold copy reads back differently.
+bool run_cold_tier_report(int chunks_y, int min_height, int max_height, bool caves, size_t cache_sections);
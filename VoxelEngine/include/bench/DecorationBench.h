@@ -0,0 +1,10 @@
+#pragma once
+
+#include <cstdint>
+
+// Generates a decorated world column by column in row-major order on one
+// thread, then again on the job pool in reversed and shuffled orders, and
+// prints generation time and how many structure writes crossed into columns
+// that were not generated yet. Returns false if any order produced different
+// blocks.
+bool run_decoration_benchmark(int chunks_y, int min_height, int max_height, bool caves, uint32_t seed, int shuffles);
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <glad/glad.h>
+
+struct FrameSample
+{
+    int frame = 0;
+    double sim_time = 0.0;
+    double cpu_ms = 0.0;      // CPU time to build and submit the frame (before swap)
+    double frame_ms = 0.0;    // wall time including swap
+    double gpu_ms = -1.0;     // GL_TIME_ELAPSED; filled in once the query resolves
+    uint32_t draw_calls = 0;
+    uint64_t indices = 0;
+    uint32_t chunk_loads = 0;
+    uint32_t chunk_meshes = 0;
+    uint32_t sections_drawn = 0;
+    uint32_t occlusion_culled = 0;  // sections rejected by the CPU depth buffer
+    double occlusion_ms = 0.0;      // raster + test time of the occlusion pass
+};
+
+// Collects per-frame timings for the flythrough benchmark. GPU time comes from
+// a small ring of timer queries so reading results rarely stalls the pipeline.
+class FrameRecorder
+{
+public:
+    FrameRecorder() = default;
+    ~FrameRecorder();
+
+    FrameRecorder(const FrameRecorder&) = delete;
+    FrameRecorder& operator=(const FrameRecorder&) = delete;
+
+    void init();
+
+    // Bracket the GL work of one frame.
+    void begin_gpu();
+    void end_gpu();
+
+    // Records the frame; its gpu_ms is resolved by a later call or by finish().
+    void add(const FrameSample& sample);
+    void finish();
+
+    void print_summary() const;
+    bool write_csv(const std::string& path) const;
+
+private:
+    void resolve_slot(size_t slot);
+
+private:
+    static constexpr size_t QUERY_RING = 8;
+
+    std::array<GLuint, QUERY_RING> m_queries{};
+    std::array<int, QUERY_RING> m_query_frame{};   // sample index per slot, -1 = idle
+    size_t m_next_slot = 0;
+
+    std::vector<FrameSample> m_samples;
+};
@@ -0,0 +1,8 @@
+#pragma once
+
+#include "world/World.h"
+
+// Times linear, Morton and tiled chunk layouts on a meshing-style face count
+// and a sky-light flood fill over the mixed sections of `world`. Returns false
+// if a layout's results disagree with the linear one.
+bool run_layout_benchmark(const World& world, int iterations);
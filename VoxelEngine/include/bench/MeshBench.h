@@ -0,0 +1,7 @@
+#pragma once
+
+#include "world/World.h"
+
+// Times build_world_mesh against the per-voxel reference mesher and checks
+// that both emit the same face set. Returns false on a mismatch.
+bool run_mesh_benchmark(const World& world, int iterations);
@@ -0,0 +1,14 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+// Runs a ChunkServer on a decorated world with block ticks and sand drops,
+// and `clients` bot viewers in the same thread, each circling the world on
+// its own path. Prints bandwidth (initial sections against raw blocks, then
+// delta bytes per changed block) and server update cost. Afterwards every
+// bot's mirror is compared with the server's world over its view, and
+// malformed section streams are fed to the decoder; returns false if any
+// block differs or a malformed stream is accepted.
+bool run_server_benchmark(int chunks_y, int min_height, int max_height, bool caves, uint32_t seed,
+    const std::string& socket_path, int clients, int ticks);
@@ -0,0 +1,6 @@
+#pragma once
+
+// Generates the same terrain at full resolution and with coarse noise
+// sampling every `stride` blocks, then prints noise evaluation counts, timings
+// and the error of the coarse world (surface heights and differing voxels).
+void run_terrain_sampling_report(int chunks_y, int min_height, int max_height, int stride, bool caves, int iterations);
@@ -0,0 +1,7 @@
+#pragma once
+
+// Drops sand and carves holes into a generated world, then runs block ticks
+// and prints per-tick cost against the number of active blocks, next to the
+// cost of one naive full-world scan. The same scenario is replayed on a
+// single worker thread; returns false if the two worlds end up different.
+bool run_tick_benchmark(int chunks_y, int min_height, int max_height, bool caves, int ticks);
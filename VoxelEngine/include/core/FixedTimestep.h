@@ -0,0 +1,30 @@
+#pragma once
+
+#include <cstdint>
+
+// Fixed-step simulation clock. Frame time goes into an accumulator that is
+// drained in whole steps; the remainder is the blend factor for rendering
+// between the last two simulated states.
+class FixedTimestep
+{
+public:
+    explicit FixedTimestep(double step_seconds, int max_steps_per_frame = 8);
+
+    // Adds one frame's elapsed time and returns how many steps to simulate.
+    // After a long stall at most max_steps_per_frame run; the rest is dropped.
+    int advance(double frame_seconds);
+
+    // Cap on steps per frame; lowering it slows the simulation under load
+    // instead of lengthening frames.
+    void set_max_steps(int max_steps_per_frame);
+
+    double step_seconds() const { return m_step; }
+    float alpha() const;                            // [0, 1) toward the next step
+    uint64_t ticks() const { return m_ticks; }      // steps handed out so far
+
+private:
+    double m_step = 1.0 / 60.0;
+    int m_max_steps = 8;
+    double m_accum = 0.0;
+    uint64_t m_ticks = 0;
+};
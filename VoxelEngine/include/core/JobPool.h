@@ -0,0 +1,46 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Persistent worker threads for data-parallel frame work. parallel_for hands
+// out indices from a shared counter; the calling thread works too and the
+// call returns once every index is done. Not reentrant.
+class JobPool
+{
+public:
+    // 0 = one worker per hardware thread, minus the caller
+    explicit JobPool(int workers = 0);
+    ~JobPool();
+
+    JobPool(const JobPool&) = delete;
+    JobPool& operator=(const JobPool&) = delete;
+
+    // Threads that run parallel_for work, including the caller.
+    int size() const { return static_cast<int>(m_threads.size()) + 1; }
+
+    void parallel_for(int count, const std::function<void(int)>& fn);
+
+private:
+    void worker_main();
+    void run_indices();
+
+private:
+    std::vector<std::thread> m_threads;
+
+    std::mutex m_mutex;
+    std::condition_variable m_wake;
+    std::condition_variable m_done;
+
+    const std::function<void(int)>* m_fn = nullptr;
+    int m_count = 0;
+    std::atomic<int> m_next{ 0 };
+    int m_busy = 0;             // workers inside the current batch
+    uint64_t m_generation = 0;  // bumped per batch so workers join each one once
+    bool m_stop = false;
+};
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <string>
+
+enum class MemCategory : uint8_t
+{
+    ChunkBlocks = 0,    // Chunk block arrays
+    ChunkPacked,        // compressed cold sections
+    MeshCpu,            // CPU-side vertex/index vectors
+    GpuBuffers,         // buffer and texture storage handed to GL
+    Caches,             // unpacked cold sections held by the read cache
+    JobQueues,          // background jobs queued or in flight
+    Count
+};
+
+static constexpr size_t MEM_CATEGORY_COUNT = static_cast<size_t>(MemCategory::Count);
+
+struct MemCategoryStats
+{
+    int64_t bytes = 0;
+    int64_t peak_bytes = 0;
+    int64_t count = 0;
+    int64_t peak_count = 0;
+};
+
+using MemStatsSnapshot = std::array<MemCategoryStats, MEM_CATEGORY_COUNT>;
+
+// Counters are relaxed atomics: tracking costs a couple of uncontended
+// atomic adds per allocation and is safe from worker threads.
+void mem_track_alloc(MemCategory cat, size_t bytes, int64_t count = 1);
+void mem_track_free(MemCategory cat, size_t bytes, int64_t count = 1);
+
+const char* mem_category_name(MemCategory cat);
+
+MemCategoryStats mem_stats(MemCategory cat);
+MemStatsSnapshot mem_stats_snapshot();
+
+// "mem: chunks 1.2 MiB (300) | mesh 4.0 MiB (2) | ..."
+std::string mem_stats_log_line();
+std::string mem_stats_json();
+bool mem_stats_write_json(const std::string& path);
+
+// std allocator that charges its storage to a memory category.
+template <typename T, MemCategory Cat>
+struct TrackingAllocator
+{
+    using value_type = T;
+
+    template <typename U>
+    struct rebind { using other = TrackingAllocator<U, Cat>; };
+
+    TrackingAllocator() noexcept = default;
+
+    template <typename U>
+    TrackingAllocator(const TrackingAllocator<U, Cat>&) noexcept {}
+
+    T* allocate(size_t n)
+    {
+        T* p = static_cast<T*>(::operator new(n * sizeof(T)));
+        mem_track_alloc(Cat, n * sizeof(T));
+        return p;
+    }
+
+    void deallocate(T* p, size_t n) noexcept
+    {
+        mem_track_free(Cat, n * sizeof(T));
+        ::operator delete(p);
+    }
+
+    template <typename U>
+    bool operator==(const TrackingAllocator<U, Cat>&) const noexcept { return true; }
+};
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+
+// One rung of the quality ladder.
+struct QualityLevel
+{
+    float view_distance;        // blocks; farther sections are not drawn, far plane follows
+    int remesh_interval;        // minimum frames between world mesh rebuilds
+    int max_tick_steps;         // block tick catch-up steps per frame
+};
+
+// Picks a quality level that holds a target frame time. Frame and CPU work
+// times are smoothed; the level drops after a sustained overrun and rises
+// only after a longer stretch of headroom with no background backlog, and
+// every change is followed by a cooldown. A level that overran soon after
+// being entered doubles the headroom it needs next time, so the governor
+// settles instead of bouncing between two levels. Each decision is printed
+// and, with open_log(), appended to a CSV file.
+class QualityGovernor
+{
+public:
+    static constexpr int LEVEL_COUNT = 6;
+
+    // `world_extent`: the world's diagonal in blocks, which the top level's
+    // view distance covers.
+    QualityGovernor(double target_ms, float world_extent, int start_level = LEVEL_COUNT - 1);
+
+    // Once per frame: wall time of the last frame, the CPU part of it
+    // (excluding vsync/pacing waits) and queued background work items.
+    // Returns true when the level changed.
+    bool update(double frame_ms, double work_ms, size_t backlog);
+
+    int level() const { return m_level; }
+    const QualityLevel& settings() const;
+    double target_ms() const { return m_target_ms; }
+
+    bool open_log(const std::string& path);
+
+private:
+    void change_level(int to, const char* reason, size_t backlog);
+
+private:
+    double m_target_ms;
+    std::array<QualityLevel, LEVEL_COUNT> m_levels;
+    int m_level;
+
+    uint64_t m_frame = 0;
+    double m_frame_avg = 0.0;
+    double m_work_avg = 0.0;
+    size_t m_last_backlog = 0;
+    int m_over_frames = 0;          // consecutive frames over budget
+    int m_under_frames = 0;         // consecutive frames with headroom
+    int m_cooldown = 0;
+
+    std::array<int, LEVEL_COUNT> m_up_after{};  // headroom frames needed to enter each level
+    uint64_t m_level_since = 0;                 // frame the current level was entered
+    bool m_entered_up = false;
+
+    std::ofstream m_log;
+};
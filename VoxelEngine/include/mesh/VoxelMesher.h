@@ -1,5 +1,6 @@
 #pragma once
 
+#include "core/MemoryStats.h"
 #include "world/World.h"
 
 #include <vector>
@@ -14,9 +15,52 @@ struct Vertex
     uint32_t  layer;
 };
 
-uint32_t tex_layer_for_block(BlockType t);
+// CPU mesh buffers, charged to MemCategory::MeshCpu
+using MeshVertices = std::vector<Vertex, TrackingAllocator<Vertex, MemCategory::MeshCpu>>;
+using MeshIndices = std::vector<uint32_t, TrackingAllocator<uint32_t, MemCategory::MeshCpu>>;
+
+struct MeshStats
+{
+    uint32_t sections_meshed = 0;
+    uint32_t sections_skipped = 0;    // empty or buried
+};
+
+// Index range and world-space bounds of one meshed section in the world mesh,
+// so culling can skip it.
+struct SectionDraw
+{
+    glm::vec3 min;
+    glm::vec3 max;
+    uint32_t first_index = 0;
+    uint32_t index_count = 0;
+    uint32_t section = 0;       // section key, see section_key()
+};
+
+// Dense key of a section, column-major with cy fastest.
+inline uint32_t section_key(const World& world, int cx, int cy, int cz)
+{
+    return static_cast<uint32_t>(World::col_idx(cx, cz) * world.chunks_y() + cy);
+}
 
 void build_world_mesh(const World& world,
     const glm::vec3& world_origin,
-    std::vector<Vertex>& out_verts,
-    std::vector<uint32_t>& out_inds);
+    MeshVertices& out_verts,
+    MeshIndices& out_inds,
+    MeshStats* stats = nullptr,
+    std::vector<SectionDraw>* draws = nullptr);
+
+// One section on its own, indices starting at 0, for remeshing sections as
+// they change. Returns false (and empty buffers) for sections build_world_mesh
+// skips.
+bool build_section_mesh(const World& world,
+    int cx, int cy, int cz,
+    const glm::vec3& world_origin,
+    MeshVertices& out_verts,
+    MeshIndices& out_inds);
+
+// Per-voxel mesher with the same face set as build_world_mesh; kept to
+// verify and benchmark the bitmask kernel (--bench-mesher).
+void build_world_mesh_reference(const World& world,
+    const glm::vec3& world_origin,
+    MeshVertices& out_verts,
+    MeshIndices& out_inds);
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "net/Socket.h"
+#include "world/World.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+struct ChunkClientStats
+{
+    uint64_t bytes_received = 0;
+    uint64_t sections = 0;          // Section messages applied
+    uint64_t unloads = 0;
+    uint64_t ticks = 0;             // Tick messages applied
+    uint64_t delta_blocks = 0;
+    uint64_t last_tick = 0;
+};
+
+// Viewer side of ChunkServer: sends the camera and mirrors the sections in
+// view into a local World (all air until the server's Hello sizes it).
+// Applied sections are marked dirty in the mirror for remeshing, with their
+// neighbors when border blocks change. Non-blocking; one thread, which owns
+// the mirror.
+class ChunkClient
+{
+public:
+    ChunkClient() = default;
+    ~ChunkClient();
+
+    ChunkClient(const ChunkClient&) = delete;
+    ChunkClient& operator=(const ChunkClient&) = delete;
+
+    bool connect(const std::string& path);
+    bool connected() const { return m_socket != INVALID_SOCKET_HANDLE; }
+
+    // Queues a View message; sent by the next poll().
+    void set_view(float x, float y, float z, int radius);
+
+    // Sends queued messages and applies everything received. Returns false
+    // once the server is gone or sent something malformed.
+    bool poll();
+
+    World* world() { return m_world.get(); }
+    const ChunkClientStats& stats() const { return m_stats; }
+
+private:
+    bool handle_message(uint8_t type, const uint8_t* payload, size_t size);
+    bool apply_section(const uint8_t* payload, size_t size);
+    bool apply_tick(const uint8_t* payload, size_t size);
+    bool valid_section(int cx, int cy, int cz) const;
+    void mark_around(int cx, int cy, int cz);
+    void disconnect();
+
+private:
+    SocketHandle m_socket = INVALID_SOCKET_HANDLE;
+    std::vector<uint8_t> m_in;
+    std::vector<uint8_t> m_out;
+    std::unique_ptr<World> m_world;
+    ChunkClientStats m_stats;
+};
@@ -0,0 +1,91 @@
+#pragma once
+
+#include "world/World.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Wire format between ChunkServer and its viewers. Every message is a 5-byte
+// header, type (u8) and payload size (u32), followed by the payload. Integers
+// are little-endian; "varint" is 7 bits per byte, low bits first.
+//
+// Block positions inside a section are canonical, x + 16 * (y + 16 * z),
+// whatever ChunkLayout either side was built with.
+static constexpr uint32_t CHUNK_PROTOCOL_VERSION = 1;
+static constexpr size_t MESSAGE_HEADER_BYTES = 5;
+static constexpr uint32_t MAX_MESSAGE_BYTES = 1u << 20;
+
+enum class MessageType : uint8_t
+{
+    // Client to server
+    View = 1,       // f32 x, y, z (world blocks), u8 radius (sections)
+
+    // Server to client
+    Hello = 16,     // u32 protocol version, u8 chunks_x, chunks_y, chunks_z
+    Section,        // u8 cx, cy, cz, u8 SectionEncoding, data
+    Unload,         // u8 cx, cy, cz: the client drops the section (back to air)
+    Tick,           // u64 tick, varint sections, then per section: u8 cx, cy, cz,
+                    // varint count, count x (varint position gap, u8 block).
+                    // A large tick spans several Tick messages with the same tick.
+};
+
+enum class SectionEncoding : uint8_t
+{
+    Uniform = 0,    // u8 block
+    Packed,         // u8 palette size, palette, PackedChunk codes to the end
+    Raw,            // CHUNK_VOLUME blocks
+};
+
+// Sections a viewer at block position (x, y, z) asks for: within `radius`
+// sections of the camera's section, measured between section centers.
+bool section_in_view(const SectionCoord& s, float x, float y, float z, int radius);
+
+struct MessageWriter
+{
+    std::vector<uint8_t>& out;
+    size_t start;
+
+    MessageWriter(std::vector<uint8_t>& buffer, MessageType type);
+    ~MessageWriter();   // patches the payload size
+
+    MessageWriter(const MessageWriter&) = delete;
+    MessageWriter& operator=(const MessageWriter&) = delete;
+
+    void u8(uint8_t v) { out.push_back(v); }
+    void u32(uint32_t v);
+    void u64(uint64_t v);
+    void f32(float v);
+    void varint(uint64_t v);
+    void bytes(const uint8_t* data, size_t size) { out.insert(out.end(), data, data + size); }
+};
+
+// Bounds-checked reads over one payload; a short read sets `failed` and
+// returns 0 from then on.
+struct MessageReader
+{
+    const uint8_t* data;
+    size_t size;
+    size_t pos = 0;
+    bool failed = false;
+
+    MessageReader(const uint8_t* d, size_t n) : data(d), size(n) {}
+
+    uint8_t u8();
+    uint32_t u32();
+    uint64_t u64();
+    float f32();
+    uint64_t varint();
+    const uint8_t* bytes(size_t n);
+    size_t remaining() const { return size - pos; }
+};
+
+// Appends one Section message for the section's current blocks.
+void write_section_message(std::vector<uint8_t>& out, const World& world, int cx, int cy, int cz);
+
+// Decodes a Section payload after its coordinates into canonical-order blocks.
+bool read_section_blocks(MessageReader& r, uint8_t* out);
+
+// Moves blocks between a chunk and canonical order.
+void chunk_to_canonical(const Chunk& c, uint8_t* out);
+void chunk_from_canonical(Chunk& c, const uint8_t* in);
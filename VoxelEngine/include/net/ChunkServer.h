@@ -0,0 +1,111 @@
+#pragma once
+
+#include "net/Socket.h"
+#include "world/World.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+struct ChunkServerSettings
+{
+    int max_clients = 64;
+    size_t max_backlog_bytes = 512 * 1024;        // unsent bytes above which a client gets no new sections
+    size_t max_unsent_bytes = 16 * 1024 * 1024;   // unsent bytes above which a stalled client is dropped
+    int sections_per_update = 32;                 // new sections streamed to one client per update
+};
+
+struct ChunkServerStats
+{
+    uint32_t clients = 0;
+    uint64_t clients_accepted = 0;
+    uint64_t clients_stalled = 0;       // dropped for not reading their stream
+    uint64_t sections_sent = 0;
+    uint64_t section_bytes = 0;
+    uint64_t sections_encoded = 0;      // section messages built; the rest came from the cache
+    uint64_t sections_changed = 0;      // changed sections with at least one viewer
+    uint64_t delta_blocks = 0;          // block changes diffed out of them
+    uint64_t delta_bytes = 0;           // Tick messages, summed over clients
+    uint64_t bytes_sent = 0;
+    double update_ms = 0.0;             // last update()
+};
+
+// Streams a World to viewers on a local socket. Each client reports its
+// camera with View messages; the server keeps its interest set (sections in
+// view radius, dropped one section past it) and sends the sections in it
+// nearest first, then only block changes: one Tick message per update()
+// with the changes of every section the client holds.
+//
+// Changes are found by diffing each section against the version the server
+// last saw (it keeps a reference, so this costs no copies). Unchanged
+// sections are skipped by one pointer compare, so the World's dirty list is
+// left to its other users. Section messages are encoded once per section
+// version and shared by every client that needs them; the per-section delta
+// records are shared the same way.
+//
+// Block changes and whole-section resends go to every client holding the
+// section, whatever its backlog; a client that stops reading is dropped once
+// its unsent bytes pass max_unsent_bytes, so it cannot grow the server.
+//
+// Runs on the World's owning thread: poll() and update() never block.
+class ChunkServer
+{
+public:
+    explicit ChunkServer(World& world, const ChunkServerSettings& settings = {});
+    ~ChunkServer();
+
+    ChunkServer(const ChunkServer&) = delete;
+    ChunkServer& operator=(const ChunkServer&) = delete;
+
+    bool listen(const std::string& path);
+
+    // Accepts connections, reads View messages and sends what is queued.
+    void poll();
+
+    // Once per simulation tick: queues the tick's block changes, then new
+    // sections for every client, and sends.
+    void update(uint64_t tick);
+
+    const ChunkServerStats& stats() const { return m_stats; }
+
+private:
+    struct Client;
+
+    struct Baseline
+    {
+        const ChunkVersion* chunk = nullptr;    // one reference held
+        const PackedChunk* packed = nullptr;    // one reference held
+        BlockType fill = BlockType::Air;
+        uint32_t viewers = 0;                   // clients holding the section
+        std::vector<uint8_t> message;           // cached Section message, empty when stale
+    };
+
+    size_t section_index(int cx, int cy, int cz) const;
+    SectionCoord section_coord(size_t i) const;
+
+    void accept_clients();
+    bool read_client(Client& c);
+    bool handle_message(Client& c, uint8_t type, const uint8_t* payload, size_t size);
+    void update_interest(Client& c);
+    bool flush_client(Client& c);
+    void drop_client(Client& c);
+
+    void rebase(Baseline& b, const ChunkSection& sec);
+    size_t diff_section(size_t i, const ChunkSection& sec, std::vector<uint8_t>& record);
+    void stream_sections(Client& c);
+
+private:
+    World& m_world;
+    ChunkServerSettings m_settings;
+    SocketHandle m_listener;
+
+    std::vector<Baseline> m_sections;       // column-major, cy fastest
+    std::vector<std::unique_ptr<Client>> m_clients;
+
+    // Per update: changed sections with viewers and their delta records
+    std::vector<uint32_t> m_changed;
+    std::vector<std::vector<uint8_t>> m_records;
+
+    ChunkServerStats m_stats;
+};
@@ -0,0 +1,23 @@
+#pragma once
+
+#include "world/World.h"
+
+#include <string>
+
+struct HeadlessServerSettings
+{
+    std::string socket_path;
+    double tick_hz = 20.0;          // block ticks (and delta batches) per second
+    double seconds = 0.0;           // run time, 0 = until interrupted
+    double log_interval = 10.0;     // seconds between status lines, 0 = off
+};
+
+// Simulates `world` without a window and serves it on a local socket until
+// interrupted (Ctrl+C) or `seconds` pass. False if the socket cannot be opened.
+bool run_headless_server(World& world, const HeadlessServerSettings& settings);
+
+// `count` bot viewers connected to a server, circling the world at `height`
+// with a view radius of `radius` sections. Prints what they receive. False if
+// one fails to connect or is dropped.
+bool run_bot_clients(const std::string& socket_path, int count, int radius, float height,
+    double seconds, double log_interval);
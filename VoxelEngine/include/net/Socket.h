@@ -0,0 +1,30 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Non-blocking local stream sockets (AF_UNIX; Windows 10 and later have them
+// too). Every call returns at once: accept yields an invalid handle and
+// send/recv yield 0 when they would block.
+#ifdef _WIN32
+using SocketHandle = uintptr_t;
+#else
+using SocketHandle = int;
+#endif
+
+extern const SocketHandle INVALID_SOCKET_HANDLE;
+
+// Once per process before any other call (WSAStartup on Windows).
+bool socket_startup();
+
+// Binds `path`, replacing a stale socket file left by an earlier run.
+SocketHandle socket_listen_local(const std::string& path);
+SocketHandle socket_connect_local(const std::string& path);
+SocketHandle socket_accept(SocketHandle listener);
+
+// Bytes moved, 0 if the call would block, -1 once the peer is gone.
+long socket_send(SocketHandle s, const uint8_t* data, size_t size);
+long socket_recv(SocketHandle s, uint8_t* data, size_t size);
+
+void socket_close(SocketHandle s);
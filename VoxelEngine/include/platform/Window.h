@@ -14,11 +14,12 @@ public:
     Window(const Window&) = delete;
     Window& operator=(const Window&) = delete;
 
-    bool init();                // glfwInit + create window + make context + gladLoadGLLoader
+    bool init(bool visible = true);   // glfwInit + create window + make context + gladLoadGLLoader
     void shutdown();            // safe to call multiple times
 
     void poll_events();
     void swap_buffers();
+    void set_vsync(bool enabled);
 
     bool should_close() const;
     void set_should_close(bool v);
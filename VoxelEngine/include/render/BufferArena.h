@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+// First-fit range allocator for sub-allocating a GPU buffer, in elements.
+// Freed ranges merge with their neighbors; grow() appends capacity.
+class BufferArena
+{
+public:
+    static constexpr size_t INVALID = static_cast<size_t>(-1);
+
+    explicit BufferArena(size_t capacity = 0);
+
+    // Offset of `size` free elements, or INVALID if no range is large enough.
+    size_t alloc(size_t size);
+    void free(size_t offset, size_t size);
+    void grow(size_t new_capacity);
+
+    size_t capacity() const { return m_capacity; }
+    size_t used() const { return m_used; }
+
+private:
+    struct Range
+    {
+        size_t offset;
+        size_t size;
+    };
+
+    std::vector<Range> m_free;      // sorted by offset, never adjacent
+    size_t m_capacity = 0;
+    size_t m_used = 0;
+};
@@ -3,13 +3,53 @@
 #include "render/Camera.h"
 #include "platform/Window.h"
 
+#include <cstdint>
+#include <glm/glm.hpp>
+
+enum MoveKey : uint8_t
+{
+    MOVE_FORWARD = 1 << 0,
+    MOVE_BACK    = 1 << 1,
+    MOVE_LEFT    = 1 << 2,
+    MOVE_RIGHT   = 1 << 3,
+    MOVE_UP      = 1 << 4,
+    MOVE_DOWN    = 1 << 5,
+    MOVE_SPRINT  = 1 << 6
+};
+
+// Everything one simulation tick consumes: held movement keys plus the look
+// direction they move along. A sequence of these replays a session exactly.
+struct MoveInput
+{
+    uint8_t keys = 0;       // MoveKey bits
+    float yaw = 0.0f;
+    float pitch = 0.0f;
+};
+
+// Camera movement runs in fixed simulation steps; mouse look is applied per
+// frame, as late as possible, directly to the rendered camera.
 class CameraController
 {
 public:
     explicit CameraController(Camera& cam);
 
-    void update(Window& window, float dt_seconds);
+    // Keys held right now plus the current look direction. Also handles Esc.
+    MoveInput sample_input(Window& window) const;
+
+    // One simulation step; depends only on the previous state, `in` and `dt`.
+    void step(const MoveInput& in, float dt_seconds);
+
+    // Late latch: applies mouse motion gathered so far to yaw/pitch. Call just
+    // before building the view matrix.
+    void apply_look(Window& window);
+
+    // Places the rendered camera between the last two simulated positions.
+    void interpolate(float alpha);
+
+    glm::vec3 sim_position() const { return m_curr_pos; }
 
 private:
     Camera& m_cam;
+    glm::vec3 m_prev_pos;
+    glm::vec3 m_curr_pos;
 };
@@ -0,0 +1,38 @@
+#pragma once
+
+#include "render/Camera.h"
+
+#include <string>
+#include <vector>
+#include <glm/glm.hpp>
+
+struct CameraKey
+{
+    float t = 0.0f;     // seconds from path start
+    glm::vec3 pos = glm::vec3(0.0f);
+    float yaw = 0.0f;
+    float pitch = 0.0f;
+};
+
+// Time-keyed camera keyframes, linearly interpolated. Text format is one key
+// per line, "t x y z yaw pitch"; blank lines and '#' comments are ignored.
+class CameraPath
+{
+public:
+    static CameraPath orbit(const glm::vec3& center, float radius, float height, float duration_seconds);
+
+    bool load(const std::string& path);
+    bool save(const std::string& path) const;
+
+    // Keys must be added in increasing time order.
+    void add_key(const CameraKey& key);
+
+    bool empty() const { return m_keys.empty(); }
+    float duration() const { return m_keys.empty() ? 0.0f : m_keys.back().t; }
+
+    // Poses `cam` at time t (clamped to the path).
+    void sample(float t, Camera& cam) const;
+
+private:
+    std::vector<CameraKey> m_keys;
+};
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <glad/glad.h>
+
+// Keeps the CPU at most `max_frames_ahead` frames ahead of the GPU with fence
+// syncs. Without it the driver may queue several frames, and every queued
+// frame adds a frame of input latency. 0 disables pacing.
+class FramePacer
+{
+public:
+    static constexpr int MAX_FRAMES_AHEAD = 4;
+
+    explicit FramePacer(int max_frames_ahead);
+    ~FramePacer();
+
+    FramePacer(const FramePacer&) = delete;
+    FramePacer& operator=(const FramePacer&) = delete;
+
+    // Blocks until the frame submitted max_frames_ahead frames ago is done.
+    // Call at the start of a frame, before input is sampled.
+    void wait();
+    // Fences the frame just submitted; call after swap_buffers.
+    void end_frame();
+
+    double last_wait_ms() const { return m_last_wait_ms; }
+
+private:
+    int m_frames_ahead = 0;
+    std::array<GLsync, MAX_FRAMES_AHEAD> m_fences{};
+    size_t m_next = 0;
+    double m_last_wait_ms = 0.0;
+};
@@ -3,6 +3,8 @@
 #include <string>
 #include <glad/glad.h>
 
+class ShaderCache;
+
 class ShaderProgram
 {
 public:
@@ -12,7 +14,9 @@ public:
     ShaderProgram(const ShaderProgram&) = delete;
     ShaderProgram& operator=(const ShaderProgram&) = delete;
 
-    bool build_from_sources(const char* vs_source, const char* fs_source);
+    // With a cache, a previously stored program binary is tried first and the
+    // sources are only compiled when it is missing or rejected.
+    bool build_from_sources(const char* vs_source, const char* fs_source, const ShaderCache* cache = nullptr);
 
     void use() const;
     GLuint id() const { return m_program; }
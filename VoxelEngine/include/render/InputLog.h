@@ -0,0 +1,30 @@
+#pragma once
+
+#include "render/CameraController.h"
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// Per-tick MoveInput record for deterministic replay of the fixed-step
+// simulation. Text format is one tick per line, "keys yaw pitch"; blank lines
+// and '#' comments are ignored. The header stores the step length; a replay
+// runs at the recorded step, overriding --sim-hz.
+class InputLog
+{
+public:
+    bool load(const std::string& path);
+    bool save(const std::string& path) const;
+
+    void set_step_seconds(double step) { m_step = step; }
+    double step_seconds() const { return m_step; }
+
+    void add(const MoveInput& in) { m_ticks.push_back(in); }
+
+    size_t size() const { return m_ticks.size(); }
+    const MoveInput& at(size_t tick) const { return m_ticks[tick]; }
+
+private:
+    double m_step = 0.0;
+    std::vector<MoveInput> m_ticks;
+};
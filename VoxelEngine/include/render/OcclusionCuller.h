@@ -0,0 +1,97 @@
+#pragma once
+
+#include "core/JobPool.h"
+#include "mesh/VoxelMesher.h"
+#include "world/World.h"
+
+#include <array>
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+
+// World-space box known to be completely solid.
+struct OccluderBox
+{
+    glm::vec3 min;
+    glm::vec3 max;
+};
+
+// Conservative occluders for the whole world: for every 4x4-block footprint a
+// slab from y = 0 up to the lowest solid run among its block columns, merged
+// along x where neighbors have the same height.
+void build_occluders(const World& world, const glm::vec3& world_origin, std::vector<OccluderBox>& out);
+
+// View distance: clears the flag of every section whose box is farther than
+// max_distance from the eye. Returns how many flags it cleared.
+uint32_t cull_by_distance(const glm::vec3& eye, float max_distance,
+    const std::vector<SectionDraw>& sections, std::vector<uint8_t>& visible);
+
+struct OcclusionStats
+{
+    uint32_t sections_tested = 0;
+    uint32_t frustum_culled = 0;
+    uint32_t occlusion_culled = 0;
+    uint32_t occluders_drawn = 0;
+    uint32_t occluders_skipped = 0;     // off screen, crossing the near plane or out of budget
+    double raster_ms = 0.0;
+    double test_ms = 0.0;
+    bool over_budget = false;
+};
+
+// CPU occlusion culling. Occluders are rasterized front to back into a small
+// 1/w depth buffer, split into horizontal bands across the job pool, until the
+// frame budget runs out. A min/max pyramid over that buffer then decides each
+// section: hidden when its nearest point is behind the farthest occluder depth
+// in every tile it covers. Anything undecided is drawn.
+class OcclusionCuller
+{
+public:
+    static constexpr int WIDTH = 256;
+    static constexpr int HEIGHT = 128;
+    static constexpr int LEVELS = 7;    // 256x128 down to 4x2
+
+    explicit OcclusionCuller(JobPool& pool);
+
+    void set_occluders(std::vector<OccluderBox> boxes) { m_occluders = std::move(boxes); }
+
+    // Writes one flag per section into `visible` (1 = draw). Raster and test
+    // work stop at budget_ms; sections not yet tested by then stay visible.
+    void cull(const glm::mat4& view_proj, const glm::vec3& eye,
+        const std::vector<SectionDraw>& sections, std::vector<uint8_t>& visible, double budget_ms);
+
+    const OcclusionStats& stats() const { return m_stats; }
+
+private:
+    struct ScreenVert
+    {
+        float x = 0.0f;
+        float y = 0.0f;
+        float inv_w = 0.0f;
+    };
+
+    struct Projected
+    {
+        std::array<ScreenVert, 8> corners{};
+        uint8_t faces = 0;      // bit per front-facing face: -x +x -y +y -z +z
+        int y0 = 0;             // screen row range covered
+        int y1 = 0;
+        float near_w = 0.0f;    // sort key, front to back
+    };
+
+    void raster_band(int y0, int y1, size_t& reached, double deadline_ms);
+    void raster_triangle(const ScreenVert& a, const ScreenVert& b, const ScreenVert& c, int y0, int y1);
+    void build_pyramid();
+    bool section_visible(const glm::mat4& view_proj, const SectionDraw& s, bool& in_frustum) const;
+
+private:
+    JobPool& m_pool;
+    std::vector<OccluderBox> m_occluders;
+    std::vector<Projected> m_projected;
+
+    // Level 0 is the depth buffer itself (nearest 1/w per pixel, 0 = empty).
+    // Coarser levels keep the farthest (min) and nearest (max) of their 2x2 children.
+    std::array<std::vector<float>, LEVELS> m_min;
+    std::array<std::vector<float>, LEVELS> m_max;
+
+    OcclusionStats m_stats;
+};
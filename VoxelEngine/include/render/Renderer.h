@@ -1,12 +1,26 @@
 #pragma once
 
 #include "render/GLShader.h"
+#include "render/ShaderCache.h"
+#include "render/StagingRing.h"
 #include "render/TextureArray.h"
+#include "render/BufferArena.h"
+#include "render/UploadScheduler.h"
 #include "mesh/VoxelMesher.h"
 
 #include <vector>
 #include <glm/glm.hpp>
 
+struct RenderStats
+{
+    uint32_t draw_calls = 0;
+    uint64_t indices = 0;
+    uint32_t sections_drawn = 0;
+};
+
+// Section meshes live in ranges of one shared vertex and index buffer
+// (grown by doubling), with indices rebased to absolute vertices on upload, so
+// neighboring sections still merge into one draw range.
 class Renderer
 {
 public:
@@ -16,18 +30,59 @@ public:
     Renderer(const Renderer&) = delete;
     Renderer& operator=(const Renderer&) = delete;
 
-    bool init();
-    void upload_mesh(const std::vector<Vertex>& verts, const std::vector<uint32_t>& inds);
-    void render(const glm::mat4& mvp);
+    bool init(size_t staging_bytes = 8 * 1024 * 1024);
+
+    // Replaces the section's mesh (an empty mesh removes it), copying through
+    // the staging ring. False if the ring has no room this frame; nothing
+    // changes then. A mesh larger than a ring segment is written directly.
+    bool upload_section(const SectionMesh& mesh);
+    void remove_section(uint32_t section);
+
+    // Resident sections, ordered by first index.
+    const std::vector<SectionDraw>& section_draws() const { return m_draws; }
+
+    // Draws only the sections flagged in `visible` (one flag per entry of
+    // `sections`), merged into as few index ranges as possible and submitted
+    // with a single glMultiDrawElements.
+    void render(const glm::mat4& mvp, const std::vector<SectionDraw>& sections, const std::vector<uint8_t>& visible);
+
+    // After the frame is submitted: fences this frame's staging writes.
+    void end_frame() { m_staging.end_frame(); }
+
+    // Counters for the most recent render() call
+    const RenderStats& stats() const { return m_stats; }
 
 private:
+    ShaderCache   m_shader_cache{ "shader_cache" };
     ShaderProgram m_prog;
     TextureArray  m_tex;
 
+    struct Resident
+    {
+        size_t first_vertex = 0;
+        size_t vertex_count = 0;
+        bool resident = false;
+    };
+
+    bool reserve(BufferArena& arena, GLuint& buffer, size_t elem_bytes, size_t count, size_t& offset);
+    void insert_draw(const SectionDraw& d);
+
     GLuint m_vao = 0;
     GLuint m_vbo = 0;
     GLuint m_ebo = 0;
 
-    GLsizei m_index_count = 0;
+    BufferArena m_vertex_arena;     // in vertices
+    BufferArena m_index_arena;      // in indices
+    StagingRing m_staging;
+
+    std::vector<Resident> m_resident;   // per section key
+    std::vector<SectionDraw> m_draws;
+
+    size_t m_gpu_bytes = 0;    // current vbo + ebo storage, for memory stats
     GLint m_u_mvp = -1;
+
+    std::vector<GLsizei> m_draw_counts;     // multi-draw scratch, reused per frame
+    std::vector<const void*> m_draw_offsets;
+
+    RenderStats m_stats;
 };
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <glad/glad.h>
+
+// On-disk cache of linked program binaries (glGetProgramBinary/glProgramBinary).
+// Entries are keyed by a hash of the shader sources and the driver's
+// vendor/renderer/version strings, so a driver update invalidates them.
+class ShaderCache
+{
+public:
+    explicit ShaderCache(std::string dir);
+
+    // Needs a current GL context. Leaves the cache disabled when the driver
+    // offers no program binary formats.
+    void init();
+
+    bool enabled() const { return m_enabled; }
+
+    uint64_t key_for(const char* vs_source, const char* fs_source) const;
+
+    // Loads a cached binary into `prog`. Returns false if there is no entry or
+    // the driver rejects it; the caller then compiles from source.
+    bool load(GLuint prog, uint64_t key) const;
+    void store(GLuint prog, uint64_t key) const;
+
+private:
+    std::string path_for(uint64_t key) const;
+
+private:
+    std::string m_dir;
+    std::string m_driver_id;
+    bool m_enabled = false;
+};
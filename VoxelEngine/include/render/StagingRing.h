@@ -0,0 +1,45 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <glad/glad.h>
+
+// Persistently mapped upload buffer split into one segment per frame in
+// flight. A frame writes into its segment and the GPU copies out of it; the
+// segment is fenced at end_frame() and reused only once that fence has
+// passed. alloc() never waits: while the GPU still reads the segment it
+// returns nullptr and the caller retries next frame.
+class StagingRing
+{
+public:
+    static constexpr int SEGMENTS = 3;
+
+    StagingRing() = default;
+    ~StagingRing();
+
+    StagingRing(const StagingRing&) = delete;
+    StagingRing& operator=(const StagingRing&) = delete;
+
+    bool init(size_t bytes);
+
+    // Room for `size` bytes in this frame's segment; `offset` is its position
+    // in buffer(). nullptr if the segment is full or still in use.
+    uint8_t* alloc(size_t size, size_t& offset);
+
+    // Fences what this frame wrote and moves on to the next segment.
+    void end_frame();
+
+    GLuint buffer() const { return m_buffer; }
+    size_t segment_bytes() const { return m_segment_bytes; }
+
+private:
+    GLuint m_buffer = 0;
+    uint8_t* m_mapped = nullptr;
+    size_t m_segment_bytes = 0;
+
+    std::array<GLsync, SEGMENTS> m_fences{};
+    int m_segment = 0;
+    size_t m_used = 0;          // bytes written into the current segment
+    bool m_checked = false;     // the current segment's fence has passed
+};
@@ -11,7 +11,7 @@ public:
     TextureArray(const TextureArray&) = delete;
     TextureArray& operator=(const TextureArray&) = delete;
 
-    bool create_grass_stone_16();      // 2-layer 16x16 RGBA8 array
+    bool create_block_textures_16();   // 16x16 RGBA8 array, one layer per BlockTexture
     void bind_unit(GLuint unit) const;
 
     GLuint id() const { return m_tex; }
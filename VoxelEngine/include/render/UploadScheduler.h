@@ -0,0 +1,103 @@
+#pragma once
+
+#include "mesh/VoxelMesher.h"
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <vector>
+#include <glm/glm.hpp>
+
+// A finished section mesh waiting for the GPU. Indices start at 0; the
+// renderer rebases them. An empty mesh removes the section.
+struct SectionMesh
+{
+    SectionDraw bounds;         // box and section key; the index range is assigned on upload
+    MeshVertices verts;
+    MeshIndices inds;
+    std::chrono::steady_clock::time_point completed;
+    uint64_t completed_frame = 0;
+    bool track_latency = true;  // false for the initial load, which would only measure startup
+
+    size_t bytes() const { return verts.size() * sizeof(Vertex) + inds.size() * sizeof(uint32_t); }
+};
+
+struct UploadBudget
+{
+    size_t bytes = 1024 * 1024;     // per frame, 0 = unlimited
+    double ms = 1.0;                // per frame, 0 = unlimited
+};
+
+struct UploadStats
+{
+    // Queue
+    size_t queued = 0;
+    size_t queued_bytes = 0;
+    size_t peak_queued = 0;
+
+    // Last run()
+    uint32_t uploaded = 0;
+    size_t bytes = 0;
+    double ms = 0.0;
+    bool ring_full = false;         // stopped early: the staging ring was still in use by the GPU
+
+    uint64_t total_uploaded = 0;
+    uint64_t total_bytes = 0;
+    uint64_t superseded = 0;        // replaced by a newer mesh of the same section before upload
+    uint64_t ring_stalls = 0;       // frames that hit ring_full
+
+    // Mesh completion to first draw, over the last LATENCY_WINDOW sections drawn
+    uint32_t awaiting_draw = 0;     // uploaded, not drawn yet
+    double latency_mean_ms = 0.0;
+    double latency_p95_ms = 0.0;
+    double latency_max_ms = 0.0;
+    double latency_mean_frames = 0.0;
+};
+
+// Time-sliced uploads of finished section meshes. Meshes wait in a queue (a
+// newer mesh of a queued section replaces the old one) and each frame the most
+// urgent go first: removals, then sections in the view frustum, then the rest,
+// nearest first within each. Uploading stops once the frame's byte or time
+// budget is spent, so a burst of remeshing spreads over several frames
+// instead of stalling one. At least one mesh goes per frame, however large,
+// so the queue always drains.
+class UploadScheduler
+{
+public:
+    static constexpr size_t LATENCY_WINDOW = 256;
+
+    // Takes one mesh to the GPU; false if it cannot take more this frame
+    // (staging ring full), which ends the frame's uploads.
+    using UploadFn = std::function<bool(const SectionMesh&)>;
+
+    void submit(SectionMesh mesh);
+    void run(const glm::mat4& view_proj, const glm::vec3& eye, const UploadBudget& budget, const UploadFn& upload);
+
+    // After drawing: one flag per entry of `draws` (1 = drawn). Sections
+    // drawn for the first time since their upload record their latency.
+    void record_draws(const std::vector<SectionDraw>& draws, const std::vector<uint8_t>& drawn, uint64_t frame);
+
+    bool empty() const { return m_queue.empty(); }
+    const UploadStats& stats() const { return m_stats; }
+
+private:
+    struct Awaiting
+    {
+        std::chrono::steady_clock::time_point completed;
+        uint64_t completed_frame = 0;
+        bool active = false;
+    };
+
+    void update_latency_stats();
+
+private:
+    std::vector<SectionMesh> m_queue;
+    std::vector<int32_t> m_queued_at;       // per section key: index in m_queue, -1 if none
+    std::vector<Awaiting> m_awaiting;       // per section key
+
+    std::vector<double> m_latency_ms;       // ring of the last LATENCY_WINDOW samples
+    std::vector<double> m_latency_frames;
+    size_t m_latency_next = 0;
+
+    UploadStats m_stats;
+};
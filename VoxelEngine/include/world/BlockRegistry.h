@@ -0,0 +1,154 @@
+#pragma once
+
+#include "world/Chunk.h"
+
+#include <array>
+#include <cstdint>
+
+// Block properties, declared once per BlockType below and compiled into flat
+// 256-entry tables indexed by the raw block byte, so hot loops do one load
+// per query instead of switching on the type.
+
+// Texture array layers, one per block texture (TextureArray builds them in
+// this order).
+enum class BlockTexture : uint8_t
+{
+    Grass = 0,
+    Stone,
+    Sand,
+    Dirt,
+    GrassSide,
+    Glass,
+    Leaves,
+    Water,
+    WoodSide,
+    WoodTop,
+    Count
+};
+
+static constexpr int BLOCK_TEXTURE_COUNT = static_cast<int>(BlockTexture::Count);
+
+// Face order shared by the mesher and the per-face texture table.
+enum BlockFace : int
+{
+    FACE_POS_X = 0,
+    FACE_NEG_X,
+    FACE_POS_Y,
+    FACE_NEG_Y,
+    FACE_POS_Z,
+    FACE_NEG_Z,
+    FACE_COUNT
+};
+
+using BlockFaceTextures = std::array<BlockTexture, FACE_COUNT>;
+
+struct BlockInfo
+{
+    BlockType type;
+    const char* name;
+    bool solid;             // supports falling blocks and stops them
+    bool opaque;            // hides neighbor faces and occludes; otherwise drawn as transparent
+    uint8_t light;          // emitted light level, 0..15
+    BlockFaceTextures faces;
+};
+
+constexpr BlockFaceTextures block_faces_all(BlockTexture t)
+{
+    return { t, t, t, t, t, t };
+}
+
+constexpr BlockFaceTextures block_faces_top_side_bottom(BlockTexture top, BlockTexture side, BlockTexture bottom)
+{
+    return { side, side, top, bottom, side, side };
+}
+
+// Indexed by BlockType. Air is never drawn; any other block that is not
+// opaque is transparent.
+inline constexpr BlockInfo BLOCK_INFOS[] = {
+    { BlockType::Air,    "air",    false, false, 0, block_faces_all(BlockTexture::Stone) },
+    { BlockType::Grass,  "grass",  true,  true,  0, block_faces_top_side_bottom(BlockTexture::Grass, BlockTexture::GrassSide, BlockTexture::Dirt) },
+    { BlockType::Stone,  "stone",  true,  true,  0, block_faces_all(BlockTexture::Stone) },
+    { BlockType::Sand,   "sand",   true,  true,  0, block_faces_all(BlockTexture::Sand) },
+    { BlockType::Glass,  "glass",  true,  false, 0, block_faces_all(BlockTexture::Glass) },
+    { BlockType::Leaves, "leaves", true,  false, 0, block_faces_all(BlockTexture::Leaves) },
+    { BlockType::Water,  "water",  false, false, 0, block_faces_all(BlockTexture::Water) },
+    { BlockType::Wood,   "wood",   true,  true,  0, block_faces_top_side_bottom(BlockTexture::WoodTop, BlockTexture::WoodSide, BlockTexture::WoodTop) },
+};
+
+static constexpr int BLOCK_TYPE_COUNT = static_cast<int>(std::size(BLOCK_INFOS));
+
+struct BlockTables
+{
+    std::array<uint8_t, 256> solid{};
+    std::array<uint8_t, 256> opaque{};
+    std::array<uint8_t, 256> light{};
+    // Transparent blocks get their own group (1, 2, ...); a face between two
+    // blocks of the same group is hidden. 0 for air and opaque blocks.
+    std::array<uint8_t, 256> cull_group{};
+    std::array<std::array<uint8_t, FACE_COUNT>, 256> face_layer{};
+    int cull_groups = 0;
+};
+
+constexpr BlockTables make_block_tables()
+{
+    BlockTables t;
+
+    for (const BlockInfo& info : BLOCK_INFOS) {
+        const uint8_t b = static_cast<uint8_t>(info.type);
+        t.solid[b] = info.solid;
+        t.opaque[b] = info.opaque;
+        t.light[b] = info.light;
+        for (int f = 0; f < FACE_COUNT; ++f) {
+            t.face_layer[b][f] = static_cast<uint8_t>(info.faces[f]);
+        }
+
+        if (info.type != BlockType::Air && !info.opaque) {
+            t.cull_group[b] = static_cast<uint8_t>(++t.cull_groups);
+        }
+    }
+    return t;
+}
+
+inline constexpr BlockTables BLOCK_TABLES = make_block_tables();
+
+static constexpr int BLOCK_CULL_GROUPS = BLOCK_TABLES.cull_groups;
+
+constexpr bool block_infos_in_type_order()
+{
+    for (int i = 0; i < BLOCK_TYPE_COUNT; ++i) {
+        if (static_cast<int>(BLOCK_INFOS[i].type) != i) return false;
+    }
+    return true;
+}
+
+static_assert(block_infos_in_type_order(), "BLOCK_INFOS must list every BlockType in enum order");
+static_assert(!BLOCK_INFOS[0].solid && !BLOCK_INFOS[0].opaque, "air must be neither solid nor opaque");
+
+inline bool block_solid(BlockType t) { return BLOCK_TABLES.solid[static_cast<uint8_t>(t)] != 0; }
+inline bool block_opaque(BlockType t) { return BLOCK_TABLES.opaque[static_cast<uint8_t>(t)] != 0; }
+inline uint8_t block_light(BlockType t) { return BLOCK_TABLES.light[static_cast<uint8_t>(t)]; }
+inline uint8_t block_cull_group(BlockType t) { return BLOCK_TABLES.cull_group[static_cast<uint8_t>(t)]; }
+
+inline uint32_t block_face_layer(BlockType t, int face)
+{
+    return BLOCK_TABLES.face_layer[static_cast<uint8_t>(t)][face];
+}
+
+inline const char* block_name(BlockType t)
+{
+    const int i = static_cast<int>(t);
+    return i < BLOCK_TYPE_COUNT ? BLOCK_INFOS[i].name : "unknown";
+}
+
+// Whether the face of `self` toward `neighbor` is drawn: never for air,
+// never against an opaque block, and not between two blocks of one
+// transparent group (water next to water).
+inline bool block_face_visible(BlockType self, BlockType neighbor)
+{
+    const uint8_t s = static_cast<uint8_t>(self);
+    const uint8_t n = static_cast<uint8_t>(neighbor);
+    const uint8_t group = BLOCK_TABLES.cull_group[s];
+    return (BLOCK_TABLES.opaque[s] || group != 0) &&
+        !BLOCK_TABLES.opaque[n] &&
+        (group == 0 || group != BLOCK_TABLES.cull_group[n]);
+}
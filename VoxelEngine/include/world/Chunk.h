@@ -1,28 +1,125 @@
 #pragma once
 
+#include "core/MemoryStats.h"
+
 #include <array>
 #include <cstdint>
+#include <cstring>
 
 static constexpr int CHUNK_X = 16;
 static constexpr int CHUNK_Y = 16;
 static constexpr int CHUNK_Z = 16;
+static constexpr int CHUNK_VOLUME = CHUNK_X * CHUNK_Y * CHUNK_Z;
+
+static_assert(CHUNK_X == 16 && CHUNK_Y == 16 && CHUNK_Z == 16, "chunk layouts assume 16^3 chunks");
 
 enum class BlockType : uint8_t
 {
     Air = 0,
     Grass = 1,
-    Stone = 2
+    Stone = 2,
+    Sand = 3,       // falls while unsupported (block ticks)
+    Glass = 4,
+    Leaves = 5,
+    Water = 6,
+    Wood = 7
 };
 
-struct Chunk
+// Per-type properties (opacity, textures, ...) live in world/BlockRegistry.h.
+
+// Voxel index layouts: map local (x, y, z) to a slot in Chunk::blocks and back.
+
+// x-major rows: +-y neighbors are 16 slots apart, +-z neighbors 256.
+struct LinearLayout
 {
-    std::array<uint8_t, CHUNK_X* CHUNK_Y* CHUNK_Z> blocks{};
+    static constexpr bool CONTIGUOUS_X = true;    // an x-row is one contiguous run
 
-    static constexpr int idx(int x, int y, int z)
+    static constexpr int index(int x, int y, int z)
     {
         return x + CHUNK_X * (y + CHUNK_Y * z);
     }
 
+    static constexpr void coords(int i, int& x, int& y, int& z)
+    {
+        x = i & 15;
+        y = (i >> 4) & 15;
+        z = i >> 8;
+    }
+};
+
+// Z-order curve: bits of x, y, z interleaved (x in bit 0).
+struct MortonLayout
+{
+    static constexpr bool CONTIGUOUS_X = false;
+
+    static constexpr int spread(int v)
+    {
+        v &= 0xF;
+        v = (v | (v << 4)) & 0x0C3;
+        v = (v | (v << 2)) & 0x249;
+        return v;
+    }
+
+    static constexpr int compact(int v)
+    {
+        v &= 0x249;
+        v = (v | (v >> 2)) & 0x0C3;
+        v = (v | (v >> 4)) & 0x00F;
+        return v;
+    }
+
+    static constexpr int index(int x, int y, int z)
+    {
+        return spread(x) | (spread(y) << 1) | (spread(z) << 2);
+    }
+
+    static constexpr void coords(int i, int& x, int& y, int& z)
+    {
+        x = compact(i);
+        y = compact(i >> 1);
+        z = compact(i >> 2);
+    }
+};
+
+// 4^3 bricks, 64 contiguous bytes each; bricks and voxels inside them are x-major.
+struct TiledLayout
+{
+    static constexpr bool CONTIGUOUS_X = false;
+
+    static constexpr int index(int x, int y, int z)
+    {
+        const int brick = (x >> 2) + 4 * ((y >> 2) + 4 * (z >> 2));
+        const int local = (x & 3) + 4 * ((y & 3) + 4 * (z & 3));
+        return brick * 64 + local;
+    }
+
+    static constexpr void coords(int i, int& x, int& y, int& z)
+    {
+        const int brick = i >> 6;
+        const int local = i & 63;
+        x = ((brick & 3) << 2) | (local & 3);
+        y = (((brick >> 2) & 3) << 2) | ((local >> 2) & 3);
+        z = ((brick >> 4) << 2) | (local >> 4);
+    }
+};
+
+template <typename Layout>
+struct BasicChunk
+{
+    using layout_type = Layout;
+
+    std::array<uint8_t, CHUNK_VOLUME> blocks{};
+
+    BasicChunk() { mem_track_alloc(MemCategory::ChunkBlocks, sizeof(blocks)); }
+    BasicChunk(const BasicChunk& o) : blocks(o.blocks) { mem_track_alloc(MemCategory::ChunkBlocks, sizeof(blocks)); }
+    BasicChunk& operator=(const BasicChunk&) = default;
+    ~BasicChunk() { mem_track_free(MemCategory::ChunkBlocks, sizeof(blocks)); }
+
+    static constexpr int idx(int x, int y, int z)
+    {
+        return Layout::index(x, y, z);
+    }
+
     BlockType get_local(int x, int y, int z) const
     {
         return static_cast<BlockType>(blocks[idx(x, y, z)]);
@@ -32,4 +129,112 @@ struct Chunk
     {
         blocks[idx(x, y, z)] = static_cast<uint8_t>(t);
     }
+
+    // Row helpers for bulk edits: operate on x in [x0, x1) of row (y, z).
+    // Linear layout turns them into memset/memcpy; others fall back per voxel.
+    void fill_row(int y, int z, int x0, int x1, BlockType t)
+    {
+        if constexpr (Layout::CONTIGUOUS_X) {
+            std::memset(&blocks[idx(x0, y, z)], static_cast<uint8_t>(t), static_cast<size_t>(x1 - x0));
+        }
+        else {
+            for (int x = x0; x < x1; ++x) set_local(x, y, z, t);
+        }
+    }
+
+    void replace_row(int y, int z, int x0, int x1, BlockType from, BlockType to)
+    {
+        const uint8_t f = static_cast<uint8_t>(from);
+        const uint8_t t = static_cast<uint8_t>(to);
+        if constexpr (Layout::CONTIGUOUS_X) {
+            // Branch-free select; vectorizes to byte compares
+            uint8_t* row = &blocks[idx(x0, y, z)];
+            for (int i = 0; i < x1 - x0; ++i) {
+                row[i] = (row[i] == f) ? t : row[i];
+            }
+        }
+        else {
+            for (int x = x0; x < x1; ++x) {
+                uint8_t& b = blocks[idx(x, y, z)];
+                b = (b == f) ? t : b;
+            }
+        }
+    }
+
+    bool row_contains(int y, int z, int x0, int x1, BlockType t) const
+    {
+        if constexpr (Layout::CONTIGUOUS_X) {
+            return std::memchr(&blocks[idx(x0, y, z)], static_cast<uint8_t>(t), static_cast<size_t>(x1 - x0)) != nullptr;
+        }
+        else {
+            for (int x = x0; x < x1; ++x) {
+                if (blocks[idx(x, y, z)] == static_cast<uint8_t>(t)) return true;
+            }
+            return false;
+        }
+    }
+
+    void read_row(int y, int z, int x0, int x1, uint8_t* out) const
+    {
+        if constexpr (Layout::CONTIGUOUS_X) {
+            std::memcpy(out, &blocks[idx(x0, y, z)], static_cast<size_t>(x1 - x0));
+        }
+        else {
+            for (int x = x0; x < x1; ++x) out[x - x0] = blocks[idx(x, y, z)];
+        }
+    }
+
+    // With skip_air, air in `src` leaves the existing block untouched.
+    void write_row(int y, int z, int x0, int x1, const uint8_t* src, bool skip_air)
+    {
+        if constexpr (Layout::CONTIGUOUS_X) {
+            uint8_t* row = &blocks[idx(x0, y, z)];
+            if (!skip_air) {
+                std::memcpy(row, src, static_cast<size_t>(x1 - x0));
+                return;
+            }
+            for (int i = 0; i < x1 - x0; ++i) {
+                row[i] = src[i] ? src[i] : row[i];
+            }
+        }
+        else {
+            for (int x = x0; x < x1; ++x) {
+                const uint8_t v = src[x - x0];
+                if (v || !skip_air) blocks[idx(x, y, z)] = v;
+            }
+        }
+    }
+
+    // Calls f(x, y, z) for every local position, in storage order.
+    template <typename F>
+    static void for_each_voxel(F&& f)
+    {
+        for (int i = 0; i < CHUNK_VOLUME; ++i) {
+            int x = 0, y = 0, z = 0;
+            Layout::coords(i, x, y, z);
+            f(x, y, z);
+        }
+    }
+
+    // Calls f(x, y, z, block) for every voxel, in storage order.
+    template <typename F>
+    void for_each_block(F&& f) const
+    {
+        for (int i = 0; i < CHUNK_VOLUME; ++i) {
+            int x = 0, y = 0, z = 0;
+            Layout::coords(i, x, y, z);
+            f(x, y, z, static_cast<BlockType>(blocks[i]));
+        }
+    }
 };
+
+// Engine-wide layout, picked at configure time (VOXEL_CHUNK_LAYOUT in CMake).
+#if defined(VOXEL_CHUNK_LAYOUT_MORTON)
+using ChunkLayout = MortonLayout;
+#elif defined(VOXEL_CHUNK_LAYOUT_TILED)
+using ChunkLayout = TiledLayout;
+#else
+using ChunkLayout = LinearLayout;
+#endif
+
+using Chunk = BasicChunk<ChunkLayout>;
@@ -0,0 +1,74 @@
+#pragma once
+
+#include "world/World.h"
+
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+struct ChunkCompressorStats
+{
+    uint64_t sections_packed = 0;
+    uint64_t packs_discarded = 0;   // section edited while its pack was in flight
+    uint64_t packs_failed = 0;      // too many block types for the palette
+    uint64_t raw_bytes = 0;         // block bytes moved to the cold tier
+    uint64_t packed_bytes = 0;      // what they cost packed
+};
+
+// Moves hot sections that have not been edited for `idle_frames` World frames
+// to the cold tier. Packing runs on a background thread; update() publishes
+// the results on the World's thread and drops any whose section changed
+// meanwhile, so edits never wait on compression. Each update() checks only
+// a slice of the world for idle sections, covering all of it every
+// `idle_frames` frames (with 0, the whole world at once).
+class ChunkCompressor
+{
+public:
+    ChunkCompressor(World& world, uint32_t idle_frames);
+    ~ChunkCompressor();
+
+    ChunkCompressor(const ChunkCompressor&) = delete;
+    ChunkCompressor& operator=(const ChunkCompressor&) = delete;
+
+    // Owning thread, once per frame.
+    void update();
+
+    // Blocks until every queued section has been packed and published.
+    void flush();
+
+    size_t in_flight() const { return m_in_flight; }
+    const ChunkCompressorStats& stats() const { return m_stats; }
+
+private:
+    struct Job
+    {
+        SectionCoord at;
+        const ChunkVersion* source = nullptr;   // one reference held
+        const PackedChunk* packed = nullptr;
+    };
+
+    void worker_main();
+    void publish_done();
+    void queue_idle_sections();
+    size_t section_index(const SectionCoord& c) const;
+
+private:
+    World& m_world;
+    uint32_t m_idle_frames;
+
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    std::condition_variable m_done_cv;
+    std::vector<Job> m_pending;
+    std::vector<Job> m_done;
+    bool m_stop = false;
+    std::thread m_thread;
+
+    // Owner thread only
+    std::vector<uint8_t> m_queued;      // per section, a job is in flight
+    size_t m_scan_next = 0;             // next section index the idle scan looks at
+    size_t m_in_flight = 0;
+    ChunkCompressorStats m_stats;
+};
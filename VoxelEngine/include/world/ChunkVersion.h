@@ -0,0 +1,45 @@
+#pragma once
+
+#include "world/Chunk.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+// One immutable version of a section's blocks. It is only written before it is
+// published; edits clone it instead. The World holds one reference to each
+// live version and snapshots hold more. Dropping the last reference hands the
+// version to the epoch reclaimer, because lock-free readers may still be using it.
+struct ChunkVersion : Chunk
+{
+    ChunkVersion() = default;
+    ChunkVersion(const ChunkVersion& o) : Chunk(o) {}
+
+    mutable std::atomic<uint32_t> refs{ 1 };
+};
+
+void chunk_version_acquire(const ChunkVersion* v);
+void chunk_version_release(const ChunkVersion* v);
+
+// Hands any other object that lock-free readers may hold to the same
+// reclaimer; `destroy` runs once no reader guard can still see it.
+void chunk_retire(const void* p, void (*destroy)(const void*));
+
+// Epoch guard for lock-free readers on any thread: while one is alive, no
+// version reachable when it was created is freed. Guards nest. Each thread
+// that takes one holds a reader slot until it exits; past 128 such threads
+// the process aborts.
+class ChunkReadGuard
+{
+public:
+    ChunkReadGuard();
+    ~ChunkReadGuard();
+
+    ChunkReadGuard(const ChunkReadGuard&) = delete;
+    ChunkReadGuard& operator=(const ChunkReadGuard&) = delete;
+};
+
+// Frees retired versions (and other retired objects) that no reader can still see. Call from the owning
+// thread once per frame (and after tearing down a World).
+void chunk_versions_collect();
+size_t chunk_versions_pending();
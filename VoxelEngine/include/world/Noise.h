@@ -3,4 +3,23 @@
 #include <cstdint>
 
 float fbm_2d(float x, float z, uint32_t seed, int octaves, float lacunarity, float gain);
+float fbm_3d(float x, float y, float z, uint32_t seed, int octaves, float lacunarity, float gain);
+
+// Conservative range of fbm_3d over the closed box [x0, x1] x [y0, y1] x [z0, z1]
+// (noise space): exact per octave, summed over octaves.
+void fbm_3d_bounds(float x0, float y0, float z0, float x1, float y1, float z1,
+    uint32_t seed, int octaves, float lacunarity, float gain, float& lo, float& hi);
+
+// Raw [0, 1) heightmap noise; terrain_height quantizes it into the band.
+// Coarse-grid generation interpolates the noise, not the quantized heights.
+float terrain_noise(int gx, int gz);
+int terrain_height_from_noise(float n, int min_height, int max_height);
+int terrain_height(int gx, int gz, int min_height, int max_height);
 int terrain_height_10_16(int gx, int gz);
+
+// Caves: a voxel is carved out when cave_noise exceeds CAVE_THRESHOLD.
+static constexpr float CAVE_THRESHOLD = 0.64f;
+
+float cave_noise(int gx, int gy, int gz);
+// Range of cave_noise over the closed block box [g0, g1] on every axis.
+void cave_noise_bounds(int gx0, int gy0, int gz0, int gx1, int gy1, int gz1, float& lo, float& hi);
@@ -0,0 +1,74 @@
+#pragma once
+
+#include "world/ChunkVersion.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Compressed, immutable copy of a section's blocks for the cold tier.
+//
+// The 4096 storage slots are coded as 256 rows of 16. Each byte is either a
+// run inside the current row, (palette index << 4) | (length - 1), or, with
+// index PACKED_REPEAT, `length` copies of the previous row. Blocks map through
+// a palette of at most PACKED_MAX_PALETTE types.
+struct PackedChunk
+{
+    static constexpr uint8_t PACKED_REPEAT = 15;
+    static constexpr size_t PACKED_MAX_PALETTE = 15;
+
+    PackedChunk(std::vector<uint8_t> palette, std::vector<uint8_t> codes);
+    ~PackedChunk();
+
+    PackedChunk(const PackedChunk&) = delete;
+    PackedChunk& operator=(const PackedChunk&) = delete;
+
+    size_t bytes() const { return sizeof(PackedChunk) + palette.capacity() + codes.capacity(); }
+
+    const std::vector<uint8_t> palette;
+    const std::vector<uint8_t> codes;
+
+    mutable std::atomic<uint32_t> refs{ 1 };
+
+    // Unpack cache bookkeeping, see packed_chunk_view()
+    mutable std::atomic<const ChunkVersion*> cached{ nullptr };
+    mutable std::atomic<uint64_t> last_use{ 0 };
+    mutable bool dead = false;      // last reference dropped; guarded by the cache mutex
+};
+
+// nullptr when the chunk uses more than PACKED_MAX_PALETTE block types.
+const PackedChunk* pack_chunk(const Chunk& c);
+void unpack_chunk(const PackedChunk& p, Chunk& out);
+
+// The same coding over any CHUNK_VOLUME block bytes (pack_chunk codes storage
+// order). pack_block_codes fails past PACKED_MAX_PALETTE types.
+// unpack_block_codes checks its input, for data from outside the process:
+// false if the codes index past the palette or do not cover exactly
+// CHUNK_VOLUME bytes, and nothing past `out + CHUNK_VOLUME` is written.
+bool pack_block_codes(const uint8_t* blocks, std::vector<uint8_t>& palette, std::vector<uint8_t>& codes);
+bool unpack_block_codes(const uint8_t* palette, size_t palette_size, const uint8_t* codes, size_t code_count, uint8_t* out);
+
+// Same ownership rules as ChunkVersion: the World and snapshots hold
+// references, the last release retires it to the epoch reclaimer.
+void packed_chunk_acquire(const PackedChunk* p);
+void packed_chunk_release(const PackedChunk* p);
+
+// Decompressed view of `p` for readers, shared through a small LRU cache of
+// unpacked versions. The result stays valid for the caller's ChunkReadGuard
+// (or until the owning thread's next chunk_versions_collect()).
+const ChunkVersion* packed_chunk_view(const PackedChunk* p);
+
+struct PackedCacheStats
+{
+    uint64_t misses = 0;            // views that had to unpack
+    uint64_t evictions = 0;
+    size_t resident = 0;            // unpacked versions held by the cache
+    size_t capacity = 0;
+    double max_unpack_us = 0.0;     // worst single miss, lock wait excluded
+};
+
+void packed_cache_set_capacity(size_t sections);
+PackedCacheStats packed_cache_stats();
+// Drops every cached version (e.g. before measuring resident memory).
+void packed_cache_clear();
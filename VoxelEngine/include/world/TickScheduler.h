@@ -0,0 +1,97 @@
+#pragma once
+
+#include "core/JobPool.h"
+#include "world/World.h"
+#include "world/WorldEdit.h"
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// Blocks with a tick rule (grass spreads and decays, sand falls).
+bool block_ticks(BlockType t);
+
+struct TickStats
+{
+    uint64_t ticks = 0;
+    uint32_t blocks_ticked = 0;     // last tick
+    uint32_t blocks_changed = 0;    // last tick
+    uint32_t sections_ticked = 0;   // last tick
+    uint32_t cross_writes = 0;      // last tick, applied after their phase
+    double ms = 0.0;                // last tick
+};
+
+// Per-block simulation. Only scheduled positions are visited: each section
+// keeps a set of positions due on the next tick, and a timer wheel holds
+// delayed ones, so a tick costs O(active blocks) whatever the world size.
+//
+// A tick runs the active sections in 8 phases by (cx, cy, cz) parity. Rules
+// read within one block of their position and write their own section
+// directly, so sections of one phase never touch each other's data and run
+// on the job pool without locks. Writes that land in a neighbor section are
+// queued and applied in order after the phase, which keeps the result
+// independent of the thread count. Changed sections are marked dirty for
+// remeshing.
+class TickScheduler
+{
+public:
+    static constexpr uint32_t WHEEL_SLOTS = 256;
+
+    TickScheduler(World& world, JobPool& pool);
+    ~TickScheduler();
+
+    TickScheduler(const TickScheduler&) = delete;
+    TickScheduler& operator=(const TickScheduler&) = delete;
+
+    // Ticks the block at (gx, gy, gz) `delay` ticks from now (0 = next tick).
+    void schedule(int gx, int gy, int gz, uint32_t delay = 0);
+
+    // Schedules every ticking block in a box or in whole sections, e.g. after
+    // an edit from outside the simulation.
+    void wake_box(const BlockBox& box);
+    void wake_sections(const std::vector<SectionCoord>& sections);
+
+    void tick();
+
+    uint64_t current_tick() const { return m_tick; }
+    size_t active_blocks() const;       // due on the next tick
+    size_t delayed_blocks() const;      // waiting in the timer wheel
+    const TickStats& stats() const { return m_stats; }
+
+    // What a tick rule sees: reads, writes and scheduling around its block.
+    class Context;
+
+private:
+    struct Timer
+    {
+        uint32_t pos;       // packed global position
+        uint64_t due;
+    };
+
+    struct SectionTicks
+    {
+        std::vector<uint16_t> active;           // local x + 16 * (y + 16 * z)
+        std::array<uint64_t, 64> queued{};      // bit per local position in `active`
+        bool listed = false;                    // in m_active_sections
+    };
+
+    struct Task;
+
+    uint32_t section_index(int cx, int cy, int cz) const;
+    void activate(int gx, int gy, int gz);
+    void run_task(Task& task);
+    void apply_phase(std::vector<Task>& tasks);
+
+private:
+    World& m_world;
+    JobPool& m_pool;
+
+    uint64_t m_tick = 0;
+    std::vector<std::unique_ptr<SectionTicks>> m_sections;     // allocated on first use
+    std::vector<uint32_t> m_active_sections;
+    std::array<std::vector<Timer>, WHEEL_SLOTS> m_wheel;
+    size_t m_delayed = 0;
+
+    TickStats m_stats;
+};
@@ -1,29 +1,224 @@
 #pragma once
 
 #include "world/Chunk.h"
+#include "world/ChunkVersion.h"
+#include "world/PackedChunk.h"
 
 #include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
 
 static constexpr int WORLD_CHUNKS_X = 6;
-static constexpr int WORLD_CHUNKS_Y = 1;
 static constexpr int WORLD_CHUNKS_Z = 6;
 
+// Vertical extent is chosen at runtime (World constructor); this is the default.
+static constexpr int DEFAULT_WORLD_CHUNKS_Y = 1;
+static constexpr int MAX_WORLD_CHUNKS_Y = 64;
+
 static constexpr int WORLD_SIZE_X = WORLD_CHUNKS_X * CHUNK_X;
-static constexpr int WORLD_SIZE_Y = WORLD_CHUNKS_Y * CHUNK_Y;
 static constexpr int WORLD_SIZE_Z = WORLD_CHUNKS_Z * CHUNK_Z;
 
+// One 16^3 vertical slice of a column, in one of three tiers: hot (a published
+// ChunkVersion), cold (a PackedChunk, read through the unpack cache) or
+// uniform (all-air and uniformly filled sections, described by fill() alone).
+//
+// The World's thread is the only writer. Other threads may read sections
+// inside a ChunkReadGuard without locking; the version they load stays valid
+// for the guard's lifetime even if the section is edited meanwhile.
+struct ChunkSection
+{
+    ChunkSection() = default;
+    ChunkSection(ChunkSection&& o) noexcept;
+    ChunkSection& operator=(ChunkSection&&) = delete;
+    ~ChunkSection();
+
+    // Block storage for reading; cold sections are unpacked transparently.
+    const ChunkVersion* chunk() const
+    {
+        if (const ChunkVersion* c = hot()) return c;
+        if (const PackedChunk* p = packed()) return packed_chunk_view(p);
+        // Going cold to hot, the packed pointer is cleared only after the hot one is set
+        return hot();
+    }
+
+    const ChunkVersion* hot() const { return m_chunk.load(std::memory_order_acquire); }
+    const PackedChunk* packed() const { return m_packed.load(std::memory_order_acquire); }
+    BlockType fill() const { return m_fill.load(std::memory_order_acquire); }
+
+    bool is_uniform() const
+    {
+        if (hot() || packed()) return false;
+        // Not a duplicate: going cold to hot, the packed pointer is cleared
+        // only after the hot one is set, so a section seen between the two
+        // loads above is hot by now
+        return hot() == nullptr;
+    }
+    bool is_empty() const { return is_uniform() && fill() == BlockType::Air; }
+
+    BlockType get_local(int x, int y, int z) const
+    {
+        const ChunkVersion* c = chunk();
+        return c ? c->get_local(x, y, z) : fill();
+    }
+
+    // Writer side. publish() and publish_packed() take over one reference;
+    // whatever storage they replace is released.
+    void publish(const ChunkVersion* v);
+    void publish_packed(const PackedChunk* p);
+    void publish_uniform(BlockType t);
+
+    bool dirty = false;         // queued in World's dirty list, needs remeshing
+    uint64_t touched = 0;       // World::frame() of the last write
+
+private:
+    std::atomic<const ChunkVersion*> m_chunk{ nullptr };
+    std::atomic<const PackedChunk*> m_packed{ nullptr };
+    std::atomic<BlockType> m_fill{ BlockType::Air };
+};
+
+struct ChunkColumn
+{
+    std::vector<ChunkSection> sections;   // indexed by cy
+    int top_section = -1;                 // highest non-empty section, -1 if all air
+};
+
+struct SectionCoord
+{
+    int cx = 0;
+    int cy = 0;
+    int cz = 0;
+};
+
+// What terrain generation had to evaluate; in the cave generator everything
+// else was decided from interval bounds.
+struct TerrainGenStats
+{
+    uint32_t sections_uniform = 0;      // whole section air or stone, no voxels touched
+    uint32_t bricks_skipped = 0;        // 16^3..4^3 cubes settled without per-voxel noise
+    uint32_t bricks_sampled = 0;        // 4^3 bricks straddling a cave boundary
+    uint64_t height_samples = 0;        // terrain_noise calls
+    uint64_t noise_samples = 0;         // cave_noise calls
+
+    TerrainGenStats& operator+=(const TerrainGenStats& o)
+    {
+        sections_uniform += o.sections_uniform;
+        bricks_skipped += o.bricks_skipped;
+        bricks_sampled += o.bricks_sampled;
+        height_samples += o.height_samples;
+        noise_samples += o.noise_samples;
+        return *this;
+    }
+};
+
+// Every section's version at one point in time. Unchanged sections share their
+// version with the live world, so a snapshot only costs memory for chunks
+// edited after it was taken.
+class WorldSnapshot
+{
+public:
+    WorldSnapshot() = default;
+    WorldSnapshot(const WorldSnapshot& o);
+    WorldSnapshot& operator=(const WorldSnapshot& o);
+    WorldSnapshot(WorldSnapshot&&) noexcept = default;
+    WorldSnapshot& operator=(WorldSnapshot&& o) noexcept;
+    ~WorldSnapshot();
+
+    bool empty() const { return m_sections.empty(); }
+
+private:
+    friend struct World;
+
+    struct Entry
+    {
+        const ChunkVersion* chunk = nullptr;    // one reference held
+        const PackedChunk* packed = nullptr;    // one reference held
+        BlockType fill = BlockType::Air;
+    };
+
+    void release_all();
+
+    int m_chunks_y = 0;
+    std::vector<Entry> m_sections;      // column-major, cy fastest
+};
+
 struct World
 {
-    std::array<Chunk, WORLD_CHUNKS_X* WORLD_CHUNKS_Y* WORLD_CHUNKS_Z> chunks{};
+    explicit World(int chunks_y = DEFAULT_WORLD_CHUNKS_Y);
+    ~World();
+
+    World(const World&) = delete;
+    World& operator=(const World&) = delete;
+
+    std::array<ChunkColumn, WORLD_CHUNKS_X* WORLD_CHUNKS_Z> columns{};
 
-    static constexpr int cidx(int cx, int cy, int cz)
+    static constexpr int col_idx(int cx, int cz)
     {
-        return cx + WORLD_CHUNKS_X * (cy + WORLD_CHUNKS_Y * cz);
+        return cx + WORLD_CHUNKS_X * cz;
     }
 
-    Chunk& chunk_at(int cx, int cy, int cz) { return chunks[cidx(cx, cy, cz)]; }
-    const Chunk& chunk_at(int cx, int cy, int cz) const { return chunks[cidx(cx, cy, cz)]; }
+    int chunks_y() const { return m_chunks_y; }
+    int size_y() const { return m_chunks_y * CHUNK_Y; }
+
+    ChunkColumn& column_at(int cx, int cz) { return columns[col_idx(cx, cz)]; }
+    const ChunkColumn& column_at(int cx, int cz) const { return columns[col_idx(cx, cz)]; }
+
+    ChunkSection& section_at(int cx, int cy, int cz) { return column_at(cx, cz).sections[cy]; }
+    const ChunkSection& section_at(int cx, int cy, int cz) const { return column_at(cx, cz).sections[cy]; }
+
+    // True for a uniform solid section whose six neighbors are uniform solid too:
+    // it cannot contribute a visible face and is skipped by the mesher.
+    bool section_buried(int cx, int cy, int cz) const;
 
+    // Sections that own a raw Chunk (hot tier) or a PackedChunk (cold tier).
+    size_t allocated_sections() const;
+    size_t packed_sections() const;
+
+    // Frame counter for section ages; edits stamp ChunkSection::touched.
+    uint64_t frame() const { return m_frame; }
+    void advance_frame() { ++m_frame; }
+
+    // Copy-on-write editing: returns a private, writable clone of the section
+    // (a uniform section is expanded to its fill block). Readers keep seeing
+    // the old version until commit_section_edit publishes the clone. With
+    // collapse_uniform, a clone whose blocks all match becomes uniform storage.
+    ChunkVersion* begin_section_edit(int cx, int cy, int cz) const;
+    void commit_section_edit(int cx, int cy, int cz, ChunkVersion* edited, bool collapse_uniform = false);
+    // Moves an unchanged hot section to the cold tier. No-op (returns false,
+    // releasing `p`) if the section no longer holds `from`.
+    bool commit_section_packed(int cx, int cy, int cz, const ChunkVersion* from, const PackedChunk* p);
+    // Drops block storage; every voxel becomes `t`.
+    void set_section_uniform(int cx, int cy, int cz, BlockType t);
+    // Re-derives top_section after edits.
+    void update_top_section(int cx, int cz);
+
+    // Queues a section for remeshing; repeated calls before the queue is
+    // taken are no-ops, so each section is listed at most once.
+    void mark_section_dirty(int cx, int cy, int cz);
+    bool has_dirty_sections() const { return !m_dirty.empty(); }
+    std::vector<SectionCoord> take_dirty_sections();
+
+    // Undo/history: O(sections) pointer copies, no block data is copied.
+    // restore() marks only the sections that differ dirty. Owning thread only.
+    WorldSnapshot snapshot() const;
+    void restore(const WorldSnapshot& snap);
+
+    // noise_stride > 1 samples noise every `stride` blocks (rounded down to a
+    // power of two, at most 16) and interpolates in between; 1 is exact.
+    void fill_terrain_noise_grass_stone(int min_height, int max_height, int noise_stride = 1, TerrainGenStats* stats = nullptr);
     void fill_terrain_noise_10_16_grass_stone();
+    // Heightmap plus 3D cave carving. Sections and sub-cubes whose cave noise
+    // range lies entirely on one side of CAVE_THRESHOLD skip per-voxel noise.
+    void fill_terrain_caves_grass_stone(int min_height, int max_height, int noise_stride = 1, TerrainGenStats* stats = nullptr);
+    // One chunk column of either generator. Columns are independent, so
+    // distinct columns may be generated concurrently and in any order.
+    void generate_column_noise(int cx, int cz, int min_height, int max_height, int noise_stride, TerrainGenStats& stats);
+    void generate_column_caves(int cx, int cz, int min_height, int max_height, int noise_stride, TerrainGenStats& stats);
     BlockType get_global(int gx, int gy, int gz) const;
+
+private:
+    int m_chunks_y = DEFAULT_WORLD_CHUNKS_Y;
+    uint64_t m_frame = 0;
+    std::vector<SectionCoord> m_dirty;
 };
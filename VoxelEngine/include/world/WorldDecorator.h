@@ -0,0 +1,90 @@
+#pragma once
+
+#include "core/JobPool.h"
+#include "world/World.h"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+struct BlockWrite
+{
+    int gx, gy, gz;
+    BlockType t;
+};
+
+struct DecorationStats
+{
+    uint32_t structures = 0;    // trees planted
+    uint64_t writes = 0;        // blocks written by structures, before merging
+    uint64_t deferred = 0;      // queued for a column that was not generated yet
+    uint64_t late = 0;          // applied directly to an already decorated neighbor
+};
+
+// Decoration stage of world generation. Structures (trees) are planned per
+// chunk column from the seed and that column's own terrain, and may reach
+// into neighbor columns. Writes into a neighbor that is not generated yet
+// wait in its pending queue and are applied when it is decorated, so no
+// column waits for another and columns can be generated concurrently.
+//
+// A write lands only on air or on a lower-ranked decoration block (leaves
+// under wood) and never replaces terrain, so overlapping structures merge to
+// the same blocks whatever order their writes arrive in.
+class WorldDecorator
+{
+public:
+    WorldDecorator(World& world, uint32_t seed);
+
+    WorldDecorator(const WorldDecorator&) = delete;
+    WorldDecorator& operator=(const WorldDecorator&) = delete;
+
+    // Plants the structures rooted in column (cx, cz) and applies the writes
+    // queued for it. Call once per column, after its terrain is generated;
+    // distinct columns may be decorated concurrently.
+    void decorate_column(int cx, int cz);
+
+    // Writes still waiting for their column.
+    size_t pending_writes();
+    DecorationStats stats() const;
+
+private:
+    struct Column
+    {
+        std::mutex mutex;
+        bool decorated = false;
+        std::vector<BlockWrite> pending;
+    };
+
+    void plan_trees(int cx, int cz, std::vector<BlockWrite>& out);
+    int surface_y(int cx, int cz, int lx, int lz) const;
+    void apply(int cx, int cz, std::vector<BlockWrite>& writes);
+
+private:
+    World& m_world;
+    uint32_t m_seed;
+    std::array<Column, WORLD_CHUNKS_X * WORLD_CHUNKS_Z> m_columns;
+
+    std::atomic<uint32_t> m_structures{ 0 };
+    std::atomic<uint64_t> m_writes{ 0 };
+    std::atomic<uint64_t> m_deferred{ 0 };
+    std::atomic<uint64_t> m_late{ 0 };
+};
+
+struct WorldGenSettings
+{
+    int min_height = 10;
+    int max_height = 16;
+    int noise_stride = 1;
+    bool caves = false;
+    uint32_t seed = 1337;       // structure placement; terrain noise is fixed
+};
+
+// Terrain plus decoration for every column, one job per column on `pool`,
+// started in `order` (World::col_idx values; empty = row-major). The result
+// does not depend on the order or the number of workers.
+void generate_decorated_world(World& world, JobPool& pool, const WorldGenSettings& settings,
+    const std::vector<int>& order = {},
+    TerrainGenStats* terrain_stats = nullptr,
+    DecorationStats* decoration_stats = nullptr);
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "world/World.h"
+
+#include <cstdint>
+#include <vector>
+
+// Half-open box of global block coordinates: [x0, x1) x [y0, y1) x [z0, z1).
+struct BlockBox
+{
+    int x0 = 0, y0 = 0, z0 = 0;
+    int x1 = 0, y1 = 0, z1 = 0;
+};
+
+// Dense copy of a box of blocks, x-major.
+struct BlockRegion
+{
+    int size_x = 0;
+    int size_y = 0;
+    int size_z = 0;
+    std::vector<uint8_t> blocks;
+
+    size_t idx(int x, int y, int z) const
+    {
+        return static_cast<size_t>(x) + static_cast<size_t>(size_x) * (static_cast<size_t>(y) + static_cast<size_t>(size_y) * static_cast<size_t>(z));
+    }
+};
+
+// Bulk edits. Each splits the volume along section boundaries, works a row at
+// a time on Chunk::blocks, collapses fully covered sections to uniform storage
+// and marks every changed section (and touched neighbors) dirty once.
+// All return the number of sections modified; boxes are clipped to the world.
+int fill_box(World& world, const BlockBox& box, BlockType t);
+int replace_in_box(World& world, const BlockBox& box, BlockType from, BlockType to);
+int fill_sphere(World& world, float cx, float cy, float cz, float radius, BlockType t);
+
+BlockRegion copy_region(const World& world, const BlockBox& box);
+// With skip_air, air in the region leaves the world untouched (structure stamping).
+int paste_region(World& world, const BlockRegion& region, int gx, int gy, int gz, bool skip_air);
@@ -0,0 +1,136 @@
+#include "bench/ColdTierBench.h"
+#include "mesh/VoxelMesher.h"
+#include "world/ChunkCompressor.h"
+#include "world/World.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+std::unique_ptr<World> generate(int chunks_y, int min_height, int max_height, bool caves)
+{
+    auto w = std::make_unique<World>(chunks_y);
+    if (caves) w->fill_terrain_caves_grass_stone(min_height, max_height);
+    else w->fill_terrain_noise_grass_stone(min_height, max_height);
+    return w;
+}
+
+double mib(int64_t bytes)
+{
+    return static_cast<double>(bytes) / (1024.0 * 1024.0);
+}
+
+double mesh_ms(const World& world, int iterations)
+{
+    MeshVertices verts;
+    MeshIndices inds;
+    const glm::vec3 origin(0.0f);
+
+    const auto t0 = clock_type::now();
+    for (int i = 0; i < iterations; ++i) {
+        build_world_mesh(world, origin, verts, inds);
+    }
+    return std::chrono::duration<double, std::milli>(clock_type::now() - t0).count() / iterations;
+}
+
+double percentile(std::vector<double> v, double p)
+{
+    if (v.empty()) return 0.0;
+    std::sort(v.begin(), v.end());
+    return v[std::min(v.size() - 1, static_cast<size_t>(p * static_cast<double>(v.size())))];
+}
+
+} // namespace
+
+bool run_cold_tier_report(int chunks_y, int min_height, int max_height, bool caves, size_t cache_sections)
+{
+    packed_cache_set_capacity(cache_sections);
+
+    const std::unique_ptr<World> reference = generate(chunks_y, min_height, max_height, caves);
+    const int64_t ref_bytes = mem_stats(MemCategory::ChunkBlocks).bytes;
+
+    const std::unique_ptr<World> world = generate(chunks_y, min_height, max_height, caves);
+    const int64_t hot_bytes = mem_stats(MemCategory::ChunkBlocks).bytes - ref_bytes;
+    const size_t hot_sections = world->allocated_sections();
+
+    // Idle threshold 0: every mixed section is cold right away
+    const auto t0 = clock_type::now();
+    ChunkCompressorStats cstats;
+    {
+        ChunkCompressor compressor(*world, 0);
+        compressor.update();
+        compressor.flush();
+        cstats = compressor.stats();
+    }
+    const double pack_ms = std::chrono::duration<double, std::milli>(clock_type::now() - t0).count();
+    chunk_versions_collect();
+
+    const int64_t cold_bytes = mem_stats(MemCategory::ChunkBlocks).bytes - ref_bytes;
+    const int64_t packed_bytes = mem_stats(MemCategory::ChunkPacked).bytes;
+
+    // First touch of a cold section: time one read after dropping the cache
+    std::vector<SectionCoord> cold;
+    for (int cz = 0; cz < WORLD_CHUNKS_Z; ++cz) {
+        for (int cx = 0; cx < WORLD_CHUNKS_X; ++cx) {
+            for (int cy = 0; cy < world->chunks_y(); ++cy) {
+                if (world->section_at(cx, cy, cz).packed()) cold.push_back(SectionCoord{ cx, cy, cz });
+            }
+        }
+    }
+
+    std::vector<double> touch_us;
+    std::mt19937 rng(1234);
+    for (int i = 0; i < 512 && !cold.empty(); ++i) {
+        packed_cache_clear();
+        chunk_versions_collect();
+
+        const SectionCoord c = cold[rng() % cold.size()];
+        const auto a = clock_type::now();
+        volatile BlockType b = world->section_at(c.cx, c.cy, c.cz).get_local(7, 7, 7);
+        (void)b;
+        touch_us.push_back(std::chrono::duration<double, std::micro>(clock_type::now() - a).count());
+    }
+
+    uint64_t mismatches = 0;
+    for (int gz = 0; gz < WORLD_SIZE_Z; ++gz) {
+        for (int gy = 0; gy < world->size_y(); ++gy) {
+            for (int gx = 0; gx < WORLD_SIZE_X; ++gx) {
+                mismatches += world->get_global(gx, gy, gz) != reference->get_global(gx, gy, gz);
+            }
+        }
+    }
+
+    const double hot_mesh_ms = mesh_ms(*reference, 5);
+    const PackedCacheStats before = packed_cache_stats();
+    const double cold_mesh_ms = mesh_ms(*world, 5);
+    const PackedCacheStats cache = packed_cache_stats();
+    const int64_t cache_bytes = mem_stats(MemCategory::Caches).bytes;
+
+    packed_cache_clear();
+    chunk_versions_collect();
+
+    std::cout << std::fixed << std::setprecision(3)
+              << "Cold tier report: " << (caves ? "caves" : "heightmap") << ", " << chunks_y * CHUNK_Y << " blocks tall\n"
+              << "  hot    : " << hot_sections << " sections, " << mib(hot_bytes) << " MiB blocks\n"
+              << "  cold   : " << cstats.sections_packed << " packed (" << cstats.packs_failed << " failed) in "
+              << pack_ms << " ms, " << mib(packed_bytes) << " MiB packed + " << mib(cold_bytes) << " MiB raw left\n"
+              << "  ratio  : " << (packed_bytes + cold_bytes > 0 ? static_cast<double>(hot_bytes) / static_cast<double>(packed_bytes + cold_bytes) : 0.0)
+              << "x less resident block memory\n"
+              << "  touch  : p50 " << percentile(touch_us, 0.5) << " us, p99 " << percentile(touch_us, 0.99)
+              << " us, max unpack " << cache.max_unpack_us << " us\n"
+              << "  remesh : " << hot_mesh_ms << " ms hot, " << cold_mesh_ms << " ms cold ("
+              << cache.capacity << "-section cache, " << (cache.misses - before.misses) / 5 << " misses per remesh)\n"
+              << "  cache  : " << cache.resident << " unpacked sections, " << mib(cache_bytes) << " MiB\n"
+              << "  verify : " << mismatches << " voxels differ\n";
+
+    return mismatches == 0;
+}
@@ -0,0 +1,123 @@
+#include "bench/DecorationBench.h"
+#include "world/WorldDecorator.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <vector>
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+double ms_since(clock_type::time_point t0)
+{
+    return std::chrono::duration<double, std::milli>(clock_type::now() - t0).count();
+}
+
+uint64_t count_differences(const World& a, const World& b)
+{
+    uint64_t n = 0;
+    for (int gz = 0; gz < WORLD_SIZE_Z; ++gz) {
+        for (int gy = 0; gy < a.size_y(); ++gy) {
+            for (int gx = 0; gx < WORLD_SIZE_X; ++gx) {
+                n += a.get_global(gx, gy, gz) != b.get_global(gx, gy, gz);
+            }
+        }
+    }
+    return n;
+}
+
+uint64_t count_blocks(const World& w, BlockType t)
+{
+    uint64_t n = 0;
+    for (int gz = 0; gz < WORLD_SIZE_Z; ++gz) {
+        for (int gy = 0; gy < w.size_y(); ++gy) {
+            for (int gx = 0; gx < WORLD_SIZE_X; ++gx) {
+                n += w.get_global(gx, gy, gz) == t;
+            }
+        }
+    }
+    return n;
+}
+
+} // namespace
+
+bool run_decoration_benchmark(int chunks_y, int min_height, int max_height, bool caves, uint32_t seed, int shuffles)
+{
+    WorldGenSettings settings;
+    settings.min_height = min_height;
+    settings.max_height = max_height;
+    settings.caves = caves;
+    settings.seed = seed;
+
+    constexpr int COLUMNS = WORLD_CHUNKS_X * WORLD_CHUNKS_Z;
+
+    // Reference: one thread, row-major, every neighbor to the -x/-z side done first
+    auto reference = std::make_unique<World>(chunks_y);
+    DecorationStats ref_stats;
+    const auto t0 = clock_type::now();
+    {
+        WorldDecorator decorator(*reference, settings.seed);
+        TerrainGenStats gen;
+        for (int i = 0; i < COLUMNS; ++i) {
+            const int cx = i % WORLD_CHUNKS_X;
+            const int cz = i / WORLD_CHUNKS_X;
+            if (caves) reference->generate_column_caves(cx, cz, min_height, max_height, 1, gen);
+            else reference->generate_column_noise(cx, cz, min_height, max_height, 1, gen);
+            decorator.decorate_column(cx, cz);
+        }
+        ref_stats = decorator.stats();
+    }
+    const double reference_ms = ms_since(t0);
+
+    JobPool pool(0);
+
+    std::vector<std::vector<int>> orders;
+    std::vector<int> order(COLUMNS);
+    std::iota(order.begin(), order.end(), 0);
+    orders.emplace_back(order.rbegin(), order.rend());
+    std::mt19937 rng(777);
+    for (int i = 0; i < shuffles; ++i) {
+        std::shuffle(order.begin(), order.end(), rng);
+        orders.push_back(order);
+    }
+
+    uint64_t mismatches = 0;
+    uint64_t deferred = 0;
+    uint64_t late = 0;
+    double pooled_ms = 0.0;
+    for (const std::vector<int>& o : orders) {
+        auto w = std::make_unique<World>(chunks_y);
+        DecorationStats stats;
+        const auto p0 = clock_type::now();
+        generate_decorated_world(*w, pool, settings, o, nullptr, &stats);
+        pooled_ms += ms_since(p0);
+
+        mismatches += count_differences(*reference, *w);
+        deferred += stats.deferred;
+        late += stats.late;
+        chunk_versions_collect();
+    }
+    const double runs = static_cast<double>(orders.size());
+
+    std::cout << std::fixed << std::setprecision(3)
+              << "Decoration: " << COLUMNS << " columns, " << reference->size_y() << " blocks tall"
+              << (caves ? ", caves" : "") << "\n"
+              << "  trees   : " << ref_stats.structures << " planted, " << ref_stats.writes << " writes, "
+              << count_blocks(*reference, BlockType::Wood) << " wood and "
+              << count_blocks(*reference, BlockType::Leaves) << " leaves placed\n"
+              << "  row-major, 1 thread : " << reference_ms << " ms, "
+              << ref_stats.deferred << " writes deferred, " << ref_stats.late << " applied late\n"
+              << "  shuffled, " << pool.size() << " threads : " << pooled_ms / runs << " ms mean over "
+              << orders.size() << " orders, " << static_cast<double>(deferred) / runs << " deferred, "
+              << static_cast<double>(late) / runs << " late per run\n"
+              << "  verify  : " << mismatches << " blocks differ from the row-major run\n";
+
+    return mismatches == 0;
+}
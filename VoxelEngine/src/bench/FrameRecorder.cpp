@@ -0,0 +1,135 @@
+#include "bench/FrameRecorder.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+namespace {
+
+// Nearest-rank percentile of an unsorted copy
+double percentile(std::vector<double> v, double p)
+{
+    if (v.empty()) return 0.0;
+    std::sort(v.begin(), v.end());
+    const size_t rank = static_cast<size_t>(std::ceil(p / 100.0 * static_cast<double>(v.size())));
+    return v[std::clamp<size_t>(rank, 1, v.size()) - 1];
+}
+
+void print_row(const char* name, const std::vector<double>& v)
+{
+    if (v.empty()) {
+        std::cout << "  " << std::left << std::setw(6) << name << std::right << " n/a\n";
+        return;
+    }
+
+    std::cout << "  " << std::left << std::setw(6) << name << std::right
+              << std::setw(10) << percentile(v, 50.0)
+              << std::setw(10) << percentile(v, 95.0)
+              << std::setw(10) << percentile(v, 99.0)
+              << std::setw(10) << *std::max_element(v.begin(), v.end()) << "\n";
+}
+
+} // namespace
+
+FrameRecorder::~FrameRecorder()
+{
+    if (m_queries[0]) {
+        glDeleteQueries(static_cast<GLsizei>(m_queries.size()), m_queries.data());
+        m_queries.fill(0);
+    }
+}
+
+void FrameRecorder::init()
+{
+    glCreateQueries(GL_TIME_ELAPSED, static_cast<GLsizei>(m_queries.size()), m_queries.data());
+    m_query_frame.fill(-1);
+    m_next_slot = 0;
+    m_samples.clear();
+}
+
+void FrameRecorder::begin_gpu()
+{
+    // Reusing a slot first collects the frame it measured QUERY_RING frames ago
+    resolve_slot(m_next_slot);
+    glBeginQuery(GL_TIME_ELAPSED, m_queries[m_next_slot]);
+}
+
+void FrameRecorder::end_gpu()
+{
+    glEndQuery(GL_TIME_ELAPSED);
+    m_query_frame[m_next_slot] = static_cast<int>(m_samples.size());
+    m_next_slot = (m_next_slot + 1) % QUERY_RING;
+}
+
+void FrameRecorder::add(const FrameSample& sample)
+{
+    m_samples.push_back(sample);
+}
+
+void FrameRecorder::finish()
+{
+    for (size_t slot = 0; slot < QUERY_RING; ++slot) {
+        resolve_slot(slot);
+    }
+}
+
+void FrameRecorder::resolve_slot(size_t slot)
+{
+    const int frame = m_query_frame[slot];
+    if (frame < 0) return;
+
+    GLuint64 ns = 0;
+    glGetQueryObjectui64v(m_queries[slot], GL_QUERY_RESULT, &ns);
+    if (static_cast<size_t>(frame) < m_samples.size()) {
+        m_samples[frame].gpu_ms = static_cast<double>(ns) * 1e-6;
+    }
+    m_query_frame[slot] = -1;
+}
+
+void FrameRecorder::print_summary() const
+{
+    std::vector<double> cpu;
+    std::vector<double> frame;
+    std::vector<double> gpu;
+    uint64_t draws = 0;
+    uint64_t culled = 0;
+
+    for (const FrameSample& s : m_samples) {
+        cpu.push_back(s.cpu_ms);
+        frame.push_back(s.frame_ms);
+        if (s.gpu_ms >= 0.0) gpu.push_back(s.gpu_ms);
+        draws += s.draw_calls;
+        culled += s.occlusion_culled;
+    }
+
+    std::cout << std::fixed << std::setprecision(3)
+              << "Flythrough: " << m_samples.size() << " frames, "
+              << draws << " draw calls, "
+              << culled << " sections occlusion culled\n"
+              << "  " << std::left << std::setw(6) << "ms" << std::right
+              << std::setw(10) << "p50" << std::setw(10) << "p95"
+              << std::setw(10) << "p99" << std::setw(10) << "max" << "\n";
+    print_row("cpu", cpu);
+    print_row("gpu", gpu);
+    print_row("frame", frame);
+}
+
+bool FrameRecorder::write_csv(const std::string& path) const
+{
+    std::ofstream out(path);
+    if (!out) {
+        std::cerr << "Failed to write frame timeline '" << path << "'\n";
+        return false;
+    }
+
+    out << "frame,sim_time,cpu_ms,gpu_ms,frame_ms,draw_calls,indices,chunk_loads,chunk_meshes,sections_drawn,occlusion_culled,occlusion_ms\n";
+    out << std::fixed << std::setprecision(4);
+    for (const FrameSample& s : m_samples) {
+        out << s.frame << ',' << s.sim_time << ',' << s.cpu_ms << ',' << s.gpu_ms << ',' << s.frame_ms << ','
+            << s.draw_calls << ',' << s.indices << ',' << s.chunk_loads << ',' << s.chunk_meshes << ','
+            << s.sections_drawn << ',' << s.occlusion_culled << ',' << s.occlusion_ms << '\n';
+    }
+    return static_cast<bool>(out);
+}
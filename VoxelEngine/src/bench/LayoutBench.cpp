@@ -0,0 +1,175 @@
+#include "bench/LayoutBench.h"
+
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+namespace {
+
+struct LayoutResult
+{
+    const char* name;
+    double mesh_ms;
+    double light_ms;
+    uint64_t faces;
+    uint64_t light_sum;
+};
+
+template <typename Layout>
+std::vector<BasicChunk<Layout>> copy_mixed_sections(const World& world)
+{
+    std::vector<BasicChunk<Layout>> out;
+
+    for (const ChunkColumn& col : world.columns) {
+        for (const ChunkSection& sec : col.sections) {
+            if (!sec.chunk()) continue;
+
+            BasicChunk<Layout>& c = out.emplace_back();
+            for (int z = 0; z < CHUNK_Z; ++z) {
+                for (int y = 0; y < CHUNK_Y; ++y) {
+                    for (int x = 0; x < CHUNK_X; ++x) {
+                        c.set_local(x, y, z, sec.get_local(x, y, z));
+                    }
+                }
+            }
+        }
+    }
+    return out;
+}
+
+template <typename Layout>
+bool is_air(const BasicChunk<Layout>& c, int x, int y, int z)
+{
+    if (x < 0 || x >= CHUNK_X || y < 0 || y >= CHUNK_Y || z < 0 || z >= CHUNK_Z) {
+        return true;
+    }
+    return c.get_local(x, y, z) == BlockType::Air;
+}
+
+// Meshing workload: faces of solid voxels that touch air (chunk border = air).
+template <typename Layout>
+uint64_t count_exposed_faces(const BasicChunk<Layout>& c)
+{
+    uint64_t faces = 0;
+    c.for_each_block([&](int x, int y, int z, BlockType bt) {
+        if (bt == BlockType::Air) return;
+        faces += is_air(c, x + 1, y, z) + is_air(c, x - 1, y, z) +
+            is_air(c, x, y + 1, z) + is_air(c, x, y - 1, z) +
+            is_air(c, x, y, z + 1) + is_air(c, x, y, z - 1);
+    });
+    return faces;
+}
+
+// Lighting workload: sky light 15 down open columns, then BFS through air
+// losing one level per step.
+template <typename Layout>
+uint64_t flood_sky_light(const BasicChunk<Layout>& c, std::vector<uint8_t>& light, std::vector<uint16_t>& queue)
+{
+    light.assign(CHUNK_VOLUME, 0);
+    queue.clear();
+
+    for (int z = 0; z < CHUNK_Z; ++z) {
+        for (int x = 0; x < CHUNK_X; ++x) {
+            for (int y = CHUNK_Y - 1; y >= 0 && c.get_local(x, y, z) == BlockType::Air; --y) {
+                const int i = BasicChunk<Layout>::idx(x, y, z);
+                light[i] = 15;
+                queue.push_back(static_cast<uint16_t>(i));
+            }
+        }
+    }
+
+    static constexpr int DIRS[6][3] = {
+        { 1, 0, 0 }, { -1, 0, 0 }, { 0, 1, 0 }, { 0, -1, 0 }, { 0, 0, 1 }, { 0, 0, -1 }
+    };
+
+    for (size_t head = 0; head < queue.size(); ++head) {
+        const int i = queue[head];
+        const uint8_t l = light[i];
+        if (l <= 1) continue;
+
+        int x = 0, y = 0, z = 0;
+        Layout::coords(i, x, y, z);
+
+        for (const auto& d : DIRS) {
+            const int nx = x + d[0];
+            const int ny = y + d[1];
+            const int nz = z + d[2];
+            if (nx < 0 || nx >= CHUNK_X || ny < 0 || ny >= CHUNK_Y || nz < 0 || nz >= CHUNK_Z) continue;
+
+            const int n = BasicChunk<Layout>::idx(nx, ny, nz);
+            if (c.blocks[n] != static_cast<uint8_t>(BlockType::Air) || light[n] >= l - 1) continue;
+
+            light[n] = static_cast<uint8_t>(l - 1);
+            queue.push_back(static_cast<uint16_t>(n));
+        }
+    }
+
+    uint64_t sum = 0;
+    for (uint8_t l : light) sum += l;
+    return sum;
+}
+
+template <typename Layout>
+LayoutResult bench_layout(const char* name, const World& world, int iterations)
+{
+    using clock = std::chrono::steady_clock;
+
+    const std::vector<BasicChunk<Layout>> chunks = copy_mixed_sections<Layout>(world);
+    LayoutResult r{ name, 0.0, 0.0, 0, 0 };
+
+    const auto t0 = clock::now();
+    for (int it = 0; it < iterations; ++it) {
+        r.faces = 0;
+        for (const auto& c : chunks) r.faces += count_exposed_faces(c);
+    }
+    const auto t1 = clock::now();
+
+    std::vector<uint8_t> light;
+    std::vector<uint16_t> queue;
+    for (int it = 0; it < iterations; ++it) {
+        r.light_sum = 0;
+        for (const auto& c : chunks) r.light_sum += flood_sky_light(c, light, queue);
+    }
+    const auto t2 = clock::now();
+
+    r.mesh_ms = std::chrono::duration<double, std::milli>(t1 - t0).count() / iterations;
+    r.light_ms = std::chrono::duration<double, std::milli>(t2 - t1).count() / iterations;
+    return r;
+}
+
+} // namespace
+
+bool run_layout_benchmark(const World& world, int iterations)
+{
+    if (iterations < 1) iterations = 1;
+
+    const LayoutResult results[] = {
+        bench_layout<LinearLayout>("linear", world, iterations),
+        bench_layout<MortonLayout>("morton", world, iterations),
+        bench_layout<TiledLayout>("tiled", world, iterations),
+    };
+
+    std::cout << "Layout benchmark: " << world.allocated_sections() << " mixed sections, "
+              << iterations << " iterations\n";
+    std::cout << std::left << std::setw(8) << "layout" << std::right
+              << std::setw(12) << "mesh ms" << std::setw(12) << "light ms"
+              << std::setw(12) << "faces" << std::setw(14) << "light sum" << "\n";
+
+    std::cout << std::fixed << std::setprecision(3);
+    for (const LayoutResult& r : results) {
+        std::cout << std::left << std::setw(8) << r.name << std::right
+                  << std::setw(12) << r.mesh_ms << std::setw(12) << r.light_ms
+                  << std::setw(12) << r.faces << std::setw(14) << r.light_sum << "\n";
+    }
+
+    bool same = true;
+    for (const LayoutResult& r : results) {
+        if (r.faces != results[0].faces || r.light_sum != results[0].light_sum) {
+            std::cerr << "Layout " << r.name << " disagrees with linear\n";
+            same = false;
+        }
+    }
+    return same;
+}
@@ -0,0 +1,69 @@
+#include "bench/MeshBench.h"
+#include "mesh/VoxelMesher.h"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+namespace {
+
+// One quad: its four vertices flattened (pos, normal, uv, layer).
+using FaceKey = std::array<float, 4 * 9>;
+
+std::vector<FaceKey> sorted_faces(const MeshVertices& verts)
+{
+    std::vector<FaceKey> faces(verts.size() / 4);
+
+    for (size_t f = 0; f < faces.size(); ++f) {
+        for (int k = 0; k < 4; ++k) {
+            const Vertex& v = verts[f * 4 + k];
+            float* out = faces[f].data() + k * 9;
+            out[0] = v.pos.x;    out[1] = v.pos.y;    out[2] = v.pos.z;
+            out[3] = v.normal.x; out[4] = v.normal.y; out[5] = v.normal.z;
+            out[6] = v.uv.x;     out[7] = v.uv.y;
+            out[8] = static_cast<float>(v.layer);
+        }
+    }
+
+    std::sort(faces.begin(), faces.end());
+    return faces;
+}
+
+template <typename F>
+double time_ms(int iterations, F&& f)
+{
+    const auto t0 = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i) f();
+    const auto t1 = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(t1 - t0).count() / iterations;
+}
+
+} // namespace
+
+bool run_mesh_benchmark(const World& world, int iterations)
+{
+    if (iterations < 1) iterations = 1;
+
+    const glm::vec3 origin(0.0f);
+
+    MeshVertices verts;
+    MeshIndices inds;
+    MeshVertices ref_verts;
+    MeshIndices ref_inds;
+
+    const double bitmask_ms = time_ms(iterations, [&] { build_world_mesh(world, origin, verts, inds); });
+    const double reference_ms = time_ms(iterations, [&] { build_world_mesh_reference(world, origin, ref_verts, ref_inds); });
+
+    const bool same = inds.size() == ref_inds.size() && sorted_faces(verts) == sorted_faces(ref_verts);
+
+    std::cout << std::fixed << std::setprecision(3)
+              << "Mesher benchmark: " << verts.size() / 4 << " faces, " << iterations << " iterations\n"
+              << "  reference : " << reference_ms << " ms\n"
+              << "  bitmask   : " << bitmask_ms << " ms\n"
+              << "  face sets : " << (same ? "identical" : "MISMATCH") << "\n";
+
+    return same;
+}
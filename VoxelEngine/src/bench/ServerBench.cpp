@@ -0,0 +1,217 @@
+#include "bench/ServerBench.h"
+#include "net/ChunkClient.h"
+#include "net/ChunkProtocol.h"
+#include "net/ChunkServer.h"
+#include "world/PackedChunk.h"
+#include "world/TickScheduler.h"
+#include "world/WorldDecorator.h"
+#include "world/WorldEdit.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace {
+
+constexpr int VIEW_RADIUS = 3;          // sections
+constexpr int VIEW_MOVE_TICKS = 20;     // bots report a new camera this often
+constexpr int SAND_DROP_TICKS = 5;
+constexpr int DRAIN_UPDATES = 400;      // updates without ticks to let the bots catch up
+
+struct Bot
+{
+    ChunkClient client;
+    float phase = 0.0f;
+    float x = 0.0f, y = 0.0f, z = 0.0f;
+};
+
+void move_bot(Bot& bot, int tick, float height)
+{
+    const float a = bot.phase + 0.01f * static_cast<float>(tick);
+    const float r = 0.3f * static_cast<float>(WORLD_SIZE_X);
+    bot.x = 0.5f * static_cast<float>(WORLD_SIZE_X) + r * std::cos(a);
+    bot.y = height;
+    bot.z = 0.5f * static_cast<float>(WORLD_SIZE_Z) + r * std::sin(a);
+    bot.client.set_view(bot.x, bot.y, bot.z, VIEW_RADIUS);
+}
+
+int surface_height(const World& world, int gx, int gz)
+{
+    for (int gy = world.size_y() - 1; gy >= 0; --gy) {
+        if (world.get_global(gx, gy, gz) != BlockType::Air) return gy + 1;
+    }
+    return 0;
+}
+
+double percentile(std::vector<double> v, double p)
+{
+    if (v.empty()) return 0.0;
+    std::sort(v.begin(), v.end());
+    return v[std::min(v.size() - 1, static_cast<size_t>(p * static_cast<double>(v.size())))];
+}
+
+// Blocks of `mirror` that differ from `world` in the sections `bot` has in view.
+uint64_t count_mirror_differences(const World& world, const World& mirror, const Bot& bot)
+{
+    uint64_t n = 0;
+    for (int cz = 0; cz < WORLD_CHUNKS_Z; ++cz) {
+        for (int cy = 0; cy < world.chunks_y(); ++cy) {
+            for (int cx = 0; cx < WORLD_CHUNKS_X; ++cx) {
+                if (!section_in_view(SectionCoord{ cx, cy, cz }, bot.x, bot.y, bot.z, VIEW_RADIUS)) continue;
+
+                const ChunkSection& a = world.section_at(cx, cy, cz);
+                const ChunkSection& b = mirror.section_at(cx, cy, cz);
+                for (int z = 0; z < CHUNK_Z; ++z) {
+                    for (int y = 0; y < CHUNK_Y; ++y) {
+                        for (int x = 0; x < CHUNK_X; ++x) {
+                            n += a.get_local(x, y, z) != b.get_local(x, y, z);
+                        }
+                    }
+                }
+            }
+        }
+    }
+    return n;
+}
+
+// Feeds malformed Packed sections to the decoder: each must be rejected
+// without writing past the section. Returns how many failed that.
+int check_malformed_sections()
+{
+    constexpr size_t GUARD = 2048;      // room for the longest stream below to overrun into
+    const uint8_t palette[] = { static_cast<uint8_t>(BlockType::Stone) };
+    const uint8_t run16 = 0x0F;                                                 // 16 blocks of palette entry 0
+    const uint8_t repeat16 = static_cast<uint8_t>((PackedChunk::PACKED_REPEAT << 4) | 15);
+
+    std::vector<std::vector<uint8_t>> streams;
+    streams.push_back(std::vector<uint8_t>(CHUNK_VOLUME / 16 + 1, run16));     // one run too many
+    streams.push_back(std::vector<uint8_t>(CHUNK_VOLUME / 16 + 64, run16));    // far too many
+    streams.push_back(std::vector<uint8_t>(CHUNK_VOLUME / 16 - 1, run16));     // truncated
+    streams.push_back({});                                                      // no codes at all
+    streams.push_back({ run16, 0x1F });                                         // past the palette
+    streams.push_back({ repeat16 });                                            // repeat with no row before it
+    streams.push_back({ 0x07, 0x0F });                                          // run across a row
+    {
+        std::vector<uint8_t> s(CHUNK_VOLUME / 16, run16);                       // full, then repeats
+        s.push_back(repeat16);
+        streams.push_back(s);
+        s.assign(16, run16);                                                    // 16 rows, repeat 16 more
+        for (int i = 0; i < CHUNK_VOLUME / 256 + 1; ++i) s.push_back(repeat16);
+        streams.push_back(s);
+    }
+
+    int failures = 0;
+    std::vector<uint8_t> out(CHUNK_VOLUME + GUARD);
+    for (const std::vector<uint8_t>& codes : streams) {
+        std::fill(out.begin(), out.end(), uint8_t{ 0xAB });
+        const bool ok = unpack_block_codes(palette, 1, codes.data(), codes.size(), out.data());
+        const bool guard_intact = std::all_of(out.begin() + CHUNK_VOLUME, out.end(), [](uint8_t b) { return b == 0xAB; });
+        if (ok || !guard_intact) ++failures;
+    }
+
+    // A valid stream still decodes
+    const std::vector<uint8_t> valid(CHUNK_VOLUME / 16, run16);
+    if (!unpack_block_codes(palette, 1, valid.data(), valid.size(), out.data())) ++failures;
+    return failures;
+}
+
+} // namespace
+
+bool run_server_benchmark(int chunks_y, int min_height, int max_height, bool caves, uint32_t seed,
+    const std::string& socket_path, int clients, int ticks)
+{
+    clients = std::max(clients, 1);
+    ticks = std::max(ticks, 1);
+
+    const int decoder_failures = check_malformed_sections();
+
+    auto world = std::make_unique<World>(chunks_y);
+    JobPool pool;
+    {
+        WorldGenSettings settings;
+        settings.min_height = min_height;
+        settings.max_height = max_height;
+        settings.caves = caves;
+        settings.seed = seed;
+        generate_decorated_world(*world, pool, settings);
+    }
+    TickScheduler scheduler(*world, pool);
+
+    if (!socket_startup()) return false;
+    ChunkServer server(*world);
+    if (!server.listen(socket_path)) return false;
+
+    std::vector<std::unique_ptr<Bot>> bots;
+    for (int i = 0; i < clients; ++i) {
+        auto bot = std::make_unique<Bot>();
+        if (!bot->client.connect(socket_path)) return false;
+        bot->phase = 6.2831853f * static_cast<float>(i) / static_cast<float>(clients);
+        bots.push_back(std::move(bot));
+    }
+
+    const float view_height = static_cast<float>(max_height) + 8.0f;
+    const auto pump = [&](uint64_t tick) {
+        server.poll();
+        server.update(tick);
+        for (auto& bot : bots) bot->client.poll();
+        chunk_versions_collect();
+    };
+
+    std::mt19937 rng(4242);
+    std::vector<double> update_ms;
+    for (int t = 0; t < ticks; ++t) {
+        if (t % VIEW_MOVE_TICKS == 0) {
+            for (auto& bot : bots) move_bot(*bot, t, view_height);
+        }
+
+        // Sand dropped over the terrain keeps the simulation (and the deltas) busy
+        if (t % SAND_DROP_TICKS == 0) {
+            const int gx = static_cast<int>(rng() % (WORLD_SIZE_X - 2));
+            const int gz = static_cast<int>(rng() % (WORLD_SIZE_Z - 2));
+            const int gy = std::min(surface_height(*world, gx, gz) + 8, world->size_y() - 4);
+            fill_box(*world, BlockBox{ gx, gy, gz, gx + 2, gy + 4, gz + 2 }, BlockType::Sand);
+        }
+        scheduler.wake_sections(world->take_dirty_sections());
+        scheduler.tick();
+        world->take_dirty_sections();
+
+        pump(scheduler.current_tick());
+        update_ms.push_back(server.stats().update_ms);
+    }
+
+    // No more ticks or camera moves: let every bot receive the rest of its view
+    for (int i = 0; i < DRAIN_UPDATES; ++i) pump(scheduler.current_tick());
+
+    uint64_t mismatches = 0;
+    uint64_t received = 0;
+    for (const auto& bot : bots) {
+        World* mirror = bot->client.world();
+        if (!mirror) return false;
+        mismatches += count_mirror_differences(*world, *mirror, *bot);
+        received += bot->client.stats().bytes_received;
+    }
+
+    const ChunkServerStats& s = server.stats();
+    double sum = 0.0;
+    for (const double ms : update_ms) sum += ms;
+
+    std::cout << std::fixed << std::setprecision(3)
+              << "Chunk server: " << clients << " bots, " << ticks << " ticks, " << world->size_y() << " blocks tall"
+              << (caves ? ", caves" : "") << ", view radius " << VIEW_RADIUS << " sections\n"
+              << "  sections : " << s.sections_sent << " sent in " << s.section_bytes << " bytes ("
+              << (s.sections_sent ? 100.0 * static_cast<double>(s.section_bytes) / static_cast<double>(s.sections_sent * CHUNK_VOLUME) : 0.0)
+              << "% of raw), " << s.sections_encoded << " encoded, the rest from the shared cache\n"
+              << "  deltas   : " << s.delta_blocks << " blocks in " << s.sections_changed << " section changes, "
+              << s.delta_bytes << " bytes to bots ("
+              << static_cast<double>(s.delta_bytes) / static_cast<double>(ticks * clients) << " per bot per tick)\n"
+              << "  traffic  : " << s.bytes_sent << " bytes sent, " << received << " received\n"
+              << "  update   : mean " << sum / static_cast<double>(ticks) << " ms, p99 " << percentile(update_ms, 0.99) << " ms\n"
+              << "  verify   : " << mismatches << " blocks differ between the bots' views and the server\n"
+              << "  decoder  : " << decoder_failures << " malformed sections accepted or overrun\n";
+
+    return mismatches == 0 && s.bytes_sent == received && decoder_failures == 0;
+}
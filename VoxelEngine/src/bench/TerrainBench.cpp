@@ -0,0 +1,102 @@
+#include "bench/TerrainBench.h"
+#include "world/World.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+
+namespace {
+
+struct GenRun
+{
+    std::unique_ptr<World> world;
+    TerrainGenStats stats;
+    double ms = 0.0;
+};
+
+GenRun generate(int chunks_y, int min_height, int max_height, int stride, bool caves, int iterations)
+{
+    GenRun run;
+    run.world = std::make_unique<World>(chunks_y);
+
+    const auto t0 = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        if (caves) run.world->fill_terrain_caves_grass_stone(min_height, max_height, stride, &run.stats);
+        else run.world->fill_terrain_noise_grass_stone(min_height, max_height, stride, &run.stats);
+    }
+    const auto t1 = std::chrono::steady_clock::now();
+    run.ms = std::chrono::duration<double, std::milli>(t1 - t0).count() / iterations;
+
+    // Regeneration replaced every mixed section; free the old versions now
+    chunk_versions_collect();
+    return run;
+}
+
+// Highest solid block + 1 in column (gx, gz), 0 if the column is all air.
+int surface_height(const World& world, int gx, int gz)
+{
+    for (int gy = world.size_y() - 1; gy >= 0; --gy) {
+        if (world.get_global(gx, gy, gz) != BlockType::Air) return gy + 1;
+    }
+    return 0;
+}
+
+double ratio(uint64_t full, uint64_t coarse)
+{
+    return coarse > 0 ? static_cast<double>(full) / static_cast<double>(coarse) : 0.0;
+}
+
+} // namespace
+
+void run_terrain_sampling_report(int chunks_y, int min_height, int max_height, int stride, bool caves, int iterations)
+{
+    if (iterations < 1) iterations = 1;
+
+    const GenRun full = generate(chunks_y, min_height, max_height, 1, caves, iterations);
+    const GenRun coarse = generate(chunks_y, min_height, max_height, stride, caves, iterations);
+
+    const World& a = *full.world;
+    const World& b = *coarse.world;
+
+    uint64_t columns_differ = 0;
+    uint64_t dh_sum = 0;
+    int dh_max = 0;
+    uint64_t voxels_differ = 0;
+    uint64_t solid = 0;
+
+    for (int gz = 0; gz < WORLD_SIZE_Z; ++gz) {
+        for (int gx = 0; gx < WORLD_SIZE_X; ++gx) {
+            const int dh = std::abs(surface_height(a, gx, gz) - surface_height(b, gx, gz));
+            columns_differ += dh != 0;
+            dh_sum += static_cast<uint64_t>(dh);
+            dh_max = std::max(dh_max, dh);
+
+            for (int gy = 0; gy < a.size_y(); ++gy) {
+                const BlockType ta = a.get_global(gx, gy, gz);
+                solid += ta != BlockType::Air;
+                voxels_differ += ta != b.get_global(gx, gy, gz);
+            }
+        }
+    }
+
+    const double columns = static_cast<double>(WORLD_SIZE_X) * WORLD_SIZE_Z;
+
+    std::cout << std::fixed << std::setprecision(3)
+              << "Terrain sampling report: stride " << stride << (caves ? ", caves" : ", heightmap")
+              << ", " << iterations << " iterations\n"
+              << "  full   : " << full.ms << " ms, " << full.stats.height_samples << " height + "
+              << full.stats.noise_samples << " cave samples\n"
+              << "  coarse : " << coarse.ms << " ms, " << coarse.stats.height_samples << " height + "
+              << coarse.stats.noise_samples << " cave samples\n"
+              << "  fewer  : " << ratio(full.stats.height_samples, coarse.stats.height_samples) << "x height, "
+              << ratio(full.stats.noise_samples, coarse.stats.noise_samples) << "x cave\n"
+              << "  surface: mean |dh| " << static_cast<double>(dh_sum) / columns << " blocks, max " << dh_max
+              << ", " << 100.0 * static_cast<double>(columns_differ) / columns << "% of columns differ\n"
+              << "  voxels : " << voxels_differ << " differ ("
+              << (solid ? 100.0 * static_cast<double>(voxels_differ) / static_cast<double>(solid) : 0.0)
+              << "% of solid volume)\n";
+}
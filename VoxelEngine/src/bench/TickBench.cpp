@@ -0,0 +1,129 @@
+#include "bench/TickBench.h"
+#include "world/TickScheduler.h"
+#include "world/WorldEdit.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+struct TickRun
+{
+    std::unique_ptr<World> world;
+    std::vector<double> tick_ms;
+    uint64_t blocks_ticked = 0;
+    uint64_t blocks_changed = 0;
+    uint64_t cross_writes = 0;
+    uint32_t peak_active = 0;
+};
+
+int surface_height(const World& world, int gx, int gz)
+{
+    for (int gy = world.size_y() - 1; gy >= 0; --gy) {
+        if (world.get_global(gx, gy, gz) != BlockType::Air) return gy + 1;
+    }
+    return 0;
+}
+
+TickRun run_scenario(int chunks_y, int min_height, int max_height, bool caves, int ticks, int workers)
+{
+    TickRun run;
+    run.world = std::make_unique<World>(chunks_y);
+    World& w = *run.world;
+    if (caves) w.fill_terrain_caves_grass_stone(min_height, max_height);
+    else w.fill_terrain_noise_grass_stone(min_height, max_height);
+
+    JobPool pool(workers);
+    TickScheduler scheduler(w, pool);
+
+    // Same edits in every run: pillars of sand in the air and craters that
+    // expose stone next to grass
+    std::mt19937 rng(4242);
+    for (int i = 0; i < 48; ++i) {
+        const int gx = static_cast<int>(rng() % (WORLD_SIZE_X - 2));
+        const int gz = static_cast<int>(rng() % (WORLD_SIZE_Z - 2));
+        const int gy = std::min(surface_height(w, gx, gz) + 8, w.size_y() - 6);
+        const BlockBox box{ gx, gy, gz, gx + 2, gy + 6, gz + 2 };
+        fill_box(w, box, BlockType::Sand);
+        scheduler.wake_box(box);
+    }
+    for (int i = 0; i < 12; ++i) {
+        const int gx = static_cast<int>(rng() % WORLD_SIZE_X);
+        const int gz = static_cast<int>(rng() % WORLD_SIZE_Z);
+        const int gy = surface_height(w, gx, gz);
+        fill_sphere(w, static_cast<float>(gx), static_cast<float>(gy), static_cast<float>(gz), 4.0f, BlockType::Air);
+        scheduler.wake_box(BlockBox{ gx - 6, gy - 6, gz - 6, gx + 7, gy + 7, gz + 7 });
+    }
+    w.take_dirty_sections();
+
+    for (int t = 0; t < ticks; ++t) {
+        run.peak_active = std::max(run.peak_active, static_cast<uint32_t>(scheduler.active_blocks()));
+        scheduler.tick();
+        w.take_dirty_sections();
+        chunk_versions_collect();
+
+        const TickStats& s = scheduler.stats();
+        run.tick_ms.push_back(s.ms);
+        run.blocks_ticked += s.blocks_ticked;
+        run.blocks_changed += s.blocks_changed;
+        run.cross_writes += s.cross_writes;
+    }
+    return run;
+}
+
+double percentile(std::vector<double> v, double p)
+{
+    if (v.empty()) return 0.0;
+    std::sort(v.begin(), v.end());
+    return v[std::min(v.size() - 1, static_cast<size_t>(p * static_cast<double>(v.size())))];
+}
+
+} // namespace
+
+bool run_tick_benchmark(int chunks_y, int min_height, int max_height, bool caves, int ticks)
+{
+    if (ticks < 1) ticks = 1;
+
+    const TickRun pooled = run_scenario(chunks_y, min_height, max_height, caves, ticks, 0);
+    const TickRun single = run_scenario(chunks_y, min_height, max_height, caves, ticks, 1);
+
+    uint64_t mismatches = 0;
+    uint64_t sink = 0;
+    const auto s0 = clock_type::now();
+    for (int gz = 0; gz < WORLD_SIZE_Z; ++gz) {
+        for (int gy = 0; gy < pooled.world->size_y(); ++gy) {
+            for (int gx = 0; gx < WORLD_SIZE_X; ++gx) {
+                const BlockType a = pooled.world->get_global(gx, gy, gz);
+                sink += static_cast<uint64_t>(a);
+                mismatches += a != single.world->get_global(gx, gy, gz);
+            }
+        }
+    }
+    // Two lookups per voxel above; a naive tick would do at least one
+    const double scan_ms = std::chrono::duration<double, std::milli>(clock_type::now() - s0).count() * 0.5;
+
+    double sum = 0.0;
+    for (const double ms : pooled.tick_ms) sum += ms;
+    const double mean = sum / static_cast<double>(ticks);
+    const double per_tick = static_cast<double>(pooled.blocks_ticked) / static_cast<double>(ticks);
+
+    std::cout << std::fixed << std::setprecision(3)
+              << "Block ticks: " << ticks << " ticks, " << pooled.world->size_y() << " blocks tall"
+              << (caves ? ", caves" : "") << "\n"
+              << "  cost   : mean " << mean << " ms, p99 " << percentile(pooled.tick_ms, 0.99)
+              << " ms, " << (per_tick > 0.0 ? 1000.0 * mean / per_tick : 0.0) << " us per ticked block\n"
+              << "  work   : " << per_tick << " blocks ticked per tick (peak " << pooled.peak_active << "), "
+              << pooled.blocks_changed << " changes, " << pooled.cross_writes << " cross-section writes\n"
+              << "  naive  : " << scan_ms << " ms to visit every block once (checksum " << sink % 997 << ")\n"
+              << "  verify : " << mismatches << " blocks differ from a single-worker run\n";
+
+    return mismatches == 0;
+}
@@ -0,0 +1,36 @@
+#include "core/FixedTimestep.h"
+
+#include <algorithm>
+
+FixedTimestep::FixedTimestep(double step_seconds, int max_steps_per_frame)
+    : m_step(step_seconds > 0.0 ? step_seconds : 1.0 / 60.0), m_max_steps(std::max(max_steps_per_frame, 1))
+{
+}
+
+int FixedTimestep::advance(double frame_seconds)
+{
+    m_accum += std::max(frame_seconds, 0.0);
+
+    int steps = static_cast<int>(m_accum / m_step);
+    if (steps > m_max_steps) {
+        // Falling behind: catching up would only make the next frame longer
+        steps = m_max_steps;
+        m_accum = 0.0;
+    }
+    else {
+        m_accum -= steps * m_step;
+    }
+
+    m_ticks += static_cast<uint64_t>(steps);
+    return steps;
+}
+
+void FixedTimestep::set_max_steps(int max_steps_per_frame)
+{
+    m_max_steps = std::max(max_steps_per_frame, 1);
+}
+
+float FixedTimestep::alpha() const
+{
+    return static_cast<float>(std::clamp(m_accum / m_step, 0.0, 1.0));
+}
@@ -0,0 +1,80 @@
+#include "core/JobPool.h"
+
+#include <algorithm>
+
+JobPool::JobPool(int workers)
+{
+    if (workers <= 0) {
+        workers = std::max(static_cast<int>(std::thread::hardware_concurrency()) - 1, 1);
+    }
+
+    m_threads.reserve(static_cast<size_t>(workers));
+    for (int i = 0; i < workers; ++i) {
+        m_threads.emplace_back(&JobPool::worker_main, this);
+    }
+}
+
+JobPool::~JobPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_wake.notify_all();
+
+    for (std::thread& t : m_threads) {
+        t.join();
+    }
+}
+
+void JobPool::run_indices()
+{
+    for (int i = m_next.fetch_add(1); i < m_count; i = m_next.fetch_add(1)) {
+        (*m_fn)(i);
+    }
+}
+
+void JobPool::parallel_for(int count, const std::function<void(int)>& fn)
+{
+    if (count <= 0) return;
+
+    if (count == 1 || m_threads.empty()) {
+        for (int i = 0; i < count; ++i) fn(i);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_fn = &fn;
+        m_count = count;
+        m_next.store(0);
+        m_busy = static_cast<int>(m_threads.size());
+        ++m_generation;
+    }
+    m_wake.notify_all();
+
+    run_indices();
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_done.wait(lock, [this] { return m_busy == 0; });
+    m_fn = nullptr;
+}
+
+void JobPool::worker_main()
+{
+    uint64_t seen = 0;
+
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_wake.wait(lock, [&] { return m_stop || m_generation != seen; });
+            if (m_stop) return;
+            seen = m_generation;
+        }
+
+        run_indices();
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (--m_busy == 0) m_done.notify_one();
+    }
+}
@@ -0,0 +1,131 @@
+#include "core/MemoryStats.h"
+
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+namespace {
+
+struct alignas(64) CategoryCounters
+{
+    std::atomic<int64_t> bytes{ 0 };
+    std::atomic<int64_t> peak_bytes{ 0 };
+    std::atomic<int64_t> count{ 0 };
+    std::atomic<int64_t> peak_count{ 0 };
+};
+
+std::array<CategoryCounters, MEM_CATEGORY_COUNT> g_counters;
+
+void raise_peak(std::atomic<int64_t>& peak, int64_t value)
+{
+    int64_t prev = peak.load(std::memory_order_relaxed);
+    while (value > prev && !peak.compare_exchange_weak(prev, value, std::memory_order_relaxed)) {
+    }
+}
+
+const char* const CATEGORY_NAMES[MEM_CATEGORY_COUNT] = {
+    "chunk_blocks",
+    "chunk_packed",
+    "mesh_cpu",
+    "gpu_buffers",
+    "caches",
+    "job_queues",
+};
+
+const char* const CATEGORY_SHORT[MEM_CATEGORY_COUNT] = {
+    "chunks",
+    "packed",
+    "mesh",
+    "gpu",
+    "cache",
+    "jobs",
+};
+
+} // namespace
+
+void mem_track_alloc(MemCategory cat, size_t bytes, int64_t count)
+{
+    CategoryCounters& c = g_counters[static_cast<size_t>(cat)];
+    const int64_t b = c.bytes.fetch_add(static_cast<int64_t>(bytes), std::memory_order_relaxed) + static_cast<int64_t>(bytes);
+    const int64_t n = c.count.fetch_add(count, std::memory_order_relaxed) + count;
+    raise_peak(c.peak_bytes, b);
+    raise_peak(c.peak_count, n);
+}
+
+void mem_track_free(MemCategory cat, size_t bytes, int64_t count)
+{
+    CategoryCounters& c = g_counters[static_cast<size_t>(cat)];
+    c.bytes.fetch_sub(static_cast<int64_t>(bytes), std::memory_order_relaxed);
+    c.count.fetch_sub(count, std::memory_order_relaxed);
+}
+
+const char* mem_category_name(MemCategory cat)
+{
+    const size_t i = static_cast<size_t>(cat);
+    return i < MEM_CATEGORY_COUNT ? CATEGORY_NAMES[i] : "unknown";
+}
+
+MemCategoryStats mem_stats(MemCategory cat)
+{
+    const CategoryCounters& c = g_counters[static_cast<size_t>(cat)];
+
+    MemCategoryStats s;
+    s.bytes = c.bytes.load(std::memory_order_relaxed);
+    s.peak_bytes = c.peak_bytes.load(std::memory_order_relaxed);
+    s.count = c.count.load(std::memory_order_relaxed);
+    s.peak_count = c.peak_count.load(std::memory_order_relaxed);
+    return s;
+}
+
+MemStatsSnapshot mem_stats_snapshot()
+{
+    MemStatsSnapshot snap{};
+    for (size_t i = 0; i < MEM_CATEGORY_COUNT; ++i) {
+        snap[i] = mem_stats(static_cast<MemCategory>(i));
+    }
+    return snap;
+}
+
+std::string mem_stats_log_line()
+{
+    const MemStatsSnapshot snap = mem_stats_snapshot();
+
+    std::ostringstream ss;
+    ss << std::fixed << std::setprecision(1) << "mem:";
+    for (size_t i = 0; i < MEM_CATEGORY_COUNT; ++i) {
+        ss << (i ? " |" : "") << ' ' << CATEGORY_SHORT[i] << ' '
+           << static_cast<double>(snap[i].bytes) / (1024.0 * 1024.0) << " MiB (" << snap[i].count << ")";
+    }
+    return ss.str();
+}
+
+std::string mem_stats_json()
+{
+    const MemStatsSnapshot snap = mem_stats_snapshot();
+
+    std::ostringstream ss;
+    ss << "{\n";
+    for (size_t i = 0; i < MEM_CATEGORY_COUNT; ++i) {
+        const MemCategoryStats& s = snap[i];
+        ss << "  \"" << CATEGORY_NAMES[i] << "\": { "
+           << "\"bytes\": " << s.bytes << ", "
+           << "\"peak_bytes\": " << s.peak_bytes << ", "
+           << "\"count\": " << s.count << ", "
+           << "\"peak_count\": " << s.peak_count << " }"
+           << (i + 1 < MEM_CATEGORY_COUNT ? ",\n" : "\n");
+    }
+    ss << "}\n";
+    return ss.str();
+}
+
+bool mem_stats_write_json(const std::string& path)
+{
+    std::ofstream out(path);
+    if (!out) {
+        std::cerr << "Failed to write memory stats '" << path << "'\n";
+        return false;
+    }
+    out << mem_stats_json();
+    return static_cast<bool>(out);
+}
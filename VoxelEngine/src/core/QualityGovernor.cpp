@@ -0,0 +1,127 @@
+#include "core/QualityGovernor.h"
+
+#include <algorithm>
+#include <iostream>
+
+namespace {
+
+// Lowest to highest. The top level's view distance is raised to the world's
+// extent, so it draws the whole world.
+constexpr QualityLevel LEVELS[QualityGovernor::LEVEL_COUNT] = {
+    {  32.0f, 4, 1 },
+    {  48.0f, 3, 1 },
+    {  64.0f, 2, 2 },
+    {  96.0f, 1, 4 },
+    { 128.0f, 1, 8 },
+    { 512.0f, 1, 8 },
+};
+
+constexpr double SMOOTHING = 0.1;           // EMA weight of the newest frame
+constexpr double OVER_RATIO = 1.10;         // smoothed frame time above this x target is an overrun
+constexpr double HEADROOM_RATIO = 0.70;     // smoothed CPU work below this x target is headroom
+constexpr int DOWN_AFTER = 20;              // frames of overrun before stepping down
+constexpr int UP_AFTER = 180;               // frames of headroom before stepping up
+constexpr int UP_AFTER_MAX = UP_AFTER * 16; // backoff cap for a level that keeps overrunning
+constexpr int SETTLED = 1200;               // frames at a level that clear its backoff
+constexpr int COOLDOWN = 60;                // frames after a change before the next one
+constexpr size_t BACKLOG_LIMIT = 4096;      // background items that block stepping up
+
+} // namespace
+
+QualityGovernor::QualityGovernor(double target_ms, float world_extent, int start_level)
+    : m_target_ms(target_ms), m_level(std::clamp(start_level, 0, LEVEL_COUNT - 1))
+{
+    std::copy(std::begin(LEVELS), std::end(LEVELS), m_levels.begin());
+    m_levels[LEVEL_COUNT - 1].view_distance = std::max(m_levels[LEVEL_COUNT - 1].view_distance, world_extent);
+    m_up_after.fill(UP_AFTER);
+}
+
+const QualityLevel& QualityGovernor::settings() const
+{
+    return m_levels[m_level];
+}
+
+bool QualityGovernor::open_log(const std::string& path)
+{
+    m_log.open(path);
+    if (!m_log) {
+        std::cerr << "Failed to open governor log '" << path << "'\n";
+        return false;
+    }
+    m_log << "frame,from,to,frame_ms_avg,work_ms_avg,backlog,view_distance,remesh_interval,max_tick_steps,reason\n";
+    return true;
+}
+
+bool QualityGovernor::update(double frame_ms, double work_ms, size_t backlog)
+{
+    ++m_frame;
+    if (m_frame == 1) {
+        m_frame_avg = frame_ms;
+        m_work_avg = work_ms;
+    }
+    else {
+        m_frame_avg += (frame_ms - m_frame_avg) * SMOOTHING;
+        m_work_avg += (work_ms - m_work_avg) * SMOOTHING;
+    }
+
+    const bool over = m_frame_avg > m_target_ms * OVER_RATIO;
+    // Wall time at the target can be vsync; the CPU share shows the real headroom
+    const bool headroom = m_work_avg < m_target_ms * HEADROOM_RATIO && m_frame_avg <= m_target_ms * OVER_RATIO;
+    const bool backlog_growing = backlog > BACKLOG_LIMIT && backlog >= m_last_backlog;
+    m_last_backlog = backlog;
+
+    m_over_frames = over ? m_over_frames + 1 : 0;
+    m_under_frames = (headroom && backlog <= BACKLOG_LIMIT) ? m_under_frames + 1 : 0;
+
+    if (m_frame - m_level_since == SETTLED) {
+        m_up_after[m_level] = UP_AFTER;
+    }
+
+    if (m_cooldown > 0) {
+        --m_cooldown;
+        return false;
+    }
+
+    if (m_over_frames >= DOWN_AFTER && m_level > 0) {
+        const bool failed_step_up = m_entered_up && m_frame - m_level_since < SETTLED;
+        if (failed_step_up) {
+            m_up_after[m_level] = std::min(m_up_after[m_level] * 2, UP_AFTER_MAX);
+        }
+        change_level(m_level - 1,
+            failed_step_up ? "over budget after stepping up, backing off" :
+            backlog_growing ? "over budget, backlog growing" : "over budget", backlog);
+        return true;
+    }
+    if (m_level < LEVEL_COUNT - 1 && m_under_frames >= m_up_after[m_level + 1]) {
+        change_level(m_level + 1, "headroom", backlog);
+        return true;
+    }
+    return false;
+}
+
+void QualityGovernor::change_level(int to, const char* reason, size_t backlog)
+{
+    const int from = m_level;
+    m_level = to;
+    m_level_since = m_frame;
+    m_entered_up = to > from;
+    m_over_frames = 0;
+    m_under_frames = 0;
+    m_cooldown = COOLDOWN;
+
+    const QualityLevel& q = m_levels[to];
+    std::cout << "governor: frame " << m_frame << ", level " << from << " -> " << to
+              << " (" << reason << "; frame " << m_frame_avg << " ms, work " << m_work_avg
+              << " ms, target " << m_target_ms << " ms, backlog " << backlog << "): view "
+              << q.view_distance << ", remesh every " << q.remesh_interval << ", ticks/frame "
+              << q.max_tick_steps;
+    if (to + 1 < LEVEL_COUNT) std::cout << ", next step up after " << m_up_after[to + 1] << " frames of headroom";
+    std::cout << "\n";
+
+    if (m_log) {
+        m_log << m_frame << ',' << from << ',' << to << ',' << m_frame_avg << ',' << m_work_avg << ','
+              << backlog << ',' << q.view_distance << ',' << q.remesh_interval << ',' << q.max_tick_steps << ','
+              << reason << '\n';
+        m_log.flush();
+    }
+}
@@ -1,5 +1,13 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <future>
 #include <iostream>
 #include <memory>
+#include <string>
 #include <vector>
 
 #include <glad/glad.h>
@@ -10,14 +18,299 @@
 #include "platform/Window.h"
 #include "render/Camera.h"
 #include "render/CameraController.h"
+#include "render/CameraPath.h"
+#include "render/FramePacer.h"
+#include "render/InputLog.h"
+#include "render/OcclusionCuller.h"
 #include "render/Renderer.h"
+#include "render/UploadScheduler.h"
 #include "world/World.h"
+#include "world/ChunkCompressor.h"
+#include "world/TickScheduler.h"
+#include "world/WorldEdit.h"
+#include "world/WorldDecorator.h"
 #include "mesh/VoxelMesher.h"
+#include "net/HeadlessServer.h"
+#include "bench/LayoutBench.h"
+#include "bench/MeshBench.h"
+#include "bench/TerrainBench.h"
+#include "bench/ColdTierBench.h"
+#include "bench/TickBench.h"
+#include "bench/DecorationBench.h"
+#include "bench/ServerBench.h"
+#include "bench/FrameRecorder.h"
+#include "core/FixedTimestep.h"
+#include "core/JobPool.h"
+#include "core/QualityGovernor.h"
+#include "core/MemoryStats.h"
 
-int main()
+int main(int argc, char** argv)
 {
+    // World height in blocks (rounded up to whole 16-block sections)
+    int world_height = DEFAULT_WORLD_CHUNKS_Y * CHUNK_Y;
+    bool bench_layouts = false;
+    bool bench_mesher = false;
+    bool bench_terrain = false;
+    bool bench_cold = false;
+    bool bench_ticks = false;
+    bool bench_decoration = false;
+    bool bench_server = false;
+    bool caves = false;                     // 3D density terrain instead of the plain heightmap
+    int noise_stride = 1;                   // terrain noise lattice spacing, 1 = every block
+    uint32_t seed = 1337;                   // tree placement
+    std::string flythrough;                 // camera path file, or "orbit" for the built-in path
+    std::string bench_csv = "flythrough.csv";
+    std::string record_path;
+    double mem_log_interval = 10.0;         // seconds between memory log lines, 0 = off
+    double sim_hz = 60.0;                   // fixed simulation rate
+    int frames_ahead = 1;                   // CPU frames allowed ahead of the GPU, 0 = unpaced
+    std::string record_input;
+    std::string replay_input;
+    bool occlusion = true;                  // CPU occlusion culling of sections
+    double occlusion_budget_ms = 1.0;       // per-frame cap on the occlusion pass
+    int cold_after = 600;                   // frames without edits before a section is packed, 0 = never
+    int unpack_cache = 64;                  // cold sections kept unpacked for reading
+    double tick_hz = 20.0;                  // block ticks per second, 0 = frozen
+    double target_ms = 16.6;                // frame time the quality governor holds, 0 = fixed quality
+    std::string governor_log;
+    std::string server_path;                // headless chunk server on this socket
+    std::string bot_path;                   // headless bot viewers of the server on this socket
+    int bots = 0;                           // bot count for --bot (default 1) and --bench-server (default 16)
+    double run_seconds = 0.0;               // server and bot run time, 0 = until interrupted
+    UploadBudget upload_budget;             // per-frame cap on section mesh uploads
+    int staging_mb = 8;                     // upload staging ring size
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--height") == 0 && i + 1 < argc) {
+            world_height = std::max(std::atoi(argv[++i]), CHUNK_Y);
+        }
+        else if (std::strcmp(argv[i], "--bench-layouts") == 0) {
+            bench_layouts = true;
+        }
+        else if (std::strcmp(argv[i], "--bench-mesher") == 0) {
+            bench_mesher = true;
+        }
+        else if (std::strcmp(argv[i], "--bench-terrain") == 0) {
+            bench_terrain = true;
+        }
+        else if (std::strcmp(argv[i], "--bench-cold") == 0) {
+            bench_cold = true;
+        }
+        else if (std::strcmp(argv[i], "--bench-ticks") == 0) {
+            bench_ticks = true;
+        }
+        else if (std::strcmp(argv[i], "--bench-decoration") == 0) {
+            bench_decoration = true;
+        }
+        else if (std::strcmp(argv[i], "--bench-server") == 0) {
+            bench_server = true;
+        }
+        else if (std::strcmp(argv[i], "--server") == 0 && i + 1 < argc) {
+            server_path = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--bot") == 0 && i + 1 < argc) {
+            bot_path = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--bots") == 0 && i + 1 < argc) {
+            bots = std::clamp(std::atoi(argv[++i]), 1, 256);
+        }
+        else if (std::strcmp(argv[i], "--run-seconds") == 0 && i + 1 < argc) {
+            run_seconds = std::max(std::atof(argv[++i]), 0.0);
+        }
+        else if (std::strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            seed = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        }
+        else if (std::strcmp(argv[i], "--caves") == 0) {
+            caves = true;
+        }
+        else if (std::strcmp(argv[i], "--noise-stride") == 0 && i + 1 < argc) {
+            noise_stride = std::max(std::atoi(argv[++i]), 1);
+        }
+        else if (std::strcmp(argv[i], "--flythrough") == 0 && i + 1 < argc) {
+            flythrough = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--bench-csv") == 0 && i + 1 < argc) {
+            bench_csv = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--record-path") == 0 && i + 1 < argc) {
+            record_path = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--mem-log-interval") == 0 && i + 1 < argc) {
+            mem_log_interval = std::max(std::atof(argv[++i]), 0.0);
+        }
+        else if (std::strcmp(argv[i], "--sim-hz") == 0 && i + 1 < argc) {
+            sim_hz = std::clamp(std::atof(argv[++i]), 10.0, 1000.0);
+        }
+        else if (std::strcmp(argv[i], "--frame-pacing") == 0 && i + 1 < argc) {
+            frames_ahead = std::clamp(std::atoi(argv[++i]), 0, FramePacer::MAX_FRAMES_AHEAD);
+        }
+        else if (std::strcmp(argv[i], "--record-input") == 0 && i + 1 < argc) {
+            record_input = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--replay-input") == 0 && i + 1 < argc) {
+            replay_input = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--no-occlusion") == 0) {
+            occlusion = false;
+        }
+        else if (std::strcmp(argv[i], "--occlusion-budget") == 0 && i + 1 < argc) {
+            occlusion_budget_ms = std::clamp(std::atof(argv[++i]), 0.05, 16.0);
+        }
+        else if (std::strcmp(argv[i], "--cold-after") == 0 && i + 1 < argc) {
+            cold_after = std::max(std::atoi(argv[++i]), 0);
+        }
+        else if (std::strcmp(argv[i], "--unpack-cache") == 0 && i + 1 < argc) {
+            unpack_cache = std::max(std::atoi(argv[++i]), 1);
+        }
+        else if (std::strcmp(argv[i], "--target-ms") == 0 && i + 1 < argc) {
+            target_ms = std::max(std::atof(argv[++i]), 0.0);
+        }
+        else if (std::strcmp(argv[i], "--governor-log") == 0 && i + 1 < argc) {
+            governor_log = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--tick-hz") == 0 && i + 1 < argc) {
+            tick_hz = std::clamp(std::atof(argv[++i]), 0.0, 200.0);
+        }
+        else if (std::strcmp(argv[i], "--upload-budget-kb") == 0 && i + 1 < argc) {
+            upload_budget.bytes = static_cast<size_t>(std::max(std::atoi(argv[++i]), 0)) * 1024;
+        }
+        else if (std::strcmp(argv[i], "--upload-budget-ms") == 0 && i + 1 < argc) {
+            upload_budget.ms = std::max(std::atof(argv[++i]), 0.0);
+        }
+        else if (std::strcmp(argv[i], "--staging-mb") == 0 && i + 1 < argc) {
+            staging_mb = std::clamp(std::atoi(argv[++i]), 1, 256);
+        }
+    }
+    const int world_chunks_y = std::clamp((world_height + CHUNK_Y - 1) / CHUNK_Y, 1, MAX_WORLD_CHUNKS_Y);
+    const int world_size_y = world_chunks_y * CHUNK_Y;
+
+    // Default 16-block world keeps the classic 10..16 band; taller worlds put a
+    // wider surface band a quarter of the way up.
+    int terrain_min = 10;
+    int terrain_max = 16;
+    if (world_size_y > CHUNK_Y) {
+        terrain_min = world_size_y / 4;
+        terrain_max = std::min(terrain_min + 48, world_size_y);
+    }
+
+    packed_cache_set_capacity(static_cast<size_t>(unpack_cache));
+
+    // Bots only mirror what a server sends; no local world
+    if (!bot_path.empty()) {
+        return run_bot_clients(bot_path, bots > 0 ? bots : 1, 4, static_cast<float>(terrain_max) + 8.0f,
+            run_seconds, 10.0) ? 0 : 1;
+    }
+
+    // Generate on a worker so it overlaps window creation and shader builds.
+    // World on heap (avoids large stack frame warnings)
+    auto world_job = std::async(std::launch::async, [=] {
+        auto w = std::make_unique<World>(world_chunks_y);
+
+        WorldGenSettings settings;
+        settings.min_height = terrain_min;
+        settings.max_height = terrain_max;
+        settings.noise_stride = noise_stride;
+        settings.caves = caves;
+        settings.seed = seed;
+
+        JobPool gen_pool;
+        TerrainGenStats gen;
+        DecorationStats deco;
+        generate_decorated_world(*w, gen_pool, settings, {}, &gen, &deco);
+
+        std::cout << "Decoration: " << deco.structures << " trees, "
+                  << deco.deferred << " of " << deco.writes << " writes deferred to later columns\n";
+        if (caves) {
+            const double volume = static_cast<double>(WORLD_SIZE_X) * w->size_y() * WORLD_SIZE_Z;
+            std::cout << "Terrain: " << gen.sections_uniform << " uniform sections, "
+                      << gen.bricks_sampled << " boundary bricks, "
+                      << gen.noise_samples << " cave samples ("
+                      << 100.0 * static_cast<double>(gen.noise_samples) / volume << "% of volume)\n";
+        }
+        return w;
+    });
+
+    const auto print_world_stats = [](const World& w) {
+        std::cout << "World: " << w.size_y() << " blocks tall, "
+                  << w.allocated_sections() << " of "
+                  << WORLD_CHUNKS_X * w.chunks_y() * WORLD_CHUNKS_Z << " sections allocated\n";
+    };
+
+    // Benchmarks that build their own worlds, run in this order. Unless the
+    // layout or mesher benchmarks follow on the generated world, running any
+    // of them replaces the normal session.
+    struct StandaloneBench
+    {
+        bool enabled;
+        std::function<bool()> run;
+    };
+    const StandaloneBench standalone_benches[] = {
+        { bench_terrain, [&] {
+            // Compare against the requested stride, or the usual 4-block lattice
+            run_terrain_sampling_report(world_chunks_y, terrain_min, terrain_max,
+                noise_stride > 1 ? noise_stride : 4, caves, 5);
+            return true;
+        } },
+        { bench_cold, [&] {
+            return run_cold_tier_report(world_chunks_y, terrain_min, terrain_max, caves, static_cast<size_t>(unpack_cache));
+        } },
+        { bench_ticks, [&] {
+            return run_tick_benchmark(world_chunks_y, terrain_min, terrain_max, caves, 600);
+        } },
+        { bench_decoration, [&] {
+            return run_decoration_benchmark(world_chunks_y, terrain_min, terrain_max, caves, seed, 8);
+        } },
+        { bench_server, [&] {
+            return run_server_benchmark(world_chunks_y, terrain_min, terrain_max, caves, seed,
+                server_path.empty() ? "voxel_bench.sock" : server_path, bots > 0 ? bots : 16, 600);
+        } },
+    };
+
+    bool ran_standalone = false;
+    for (const StandaloneBench& b : standalone_benches) {
+        if (!b.enabled) continue;
+        if (!b.run()) return 1;
+        ran_standalone = true;
+    }
+    if (ran_standalone && !bench_layouts && !bench_mesher) {
+        return 0;
+    }
+
+    if (!server_path.empty()) {
+        const std::unique_ptr<World> world = world_job.get();
+        print_world_stats(*world);
+
+        HeadlessServerSettings settings;
+        settings.socket_path = server_path;
+        settings.tick_hz = tick_hz;
+        settings.seconds = run_seconds;
+        return run_headless_server(*world, settings) ? 0 : 1;
+    }
+
+    if (bench_layouts || bench_mesher) {
+        const std::unique_ptr<World> world = world_job.get();
+        print_world_stats(*world);
+
+        if (bench_layouts && !run_layout_benchmark(*world, 50)) {
+            return 1;
+        }
+        if (bench_mesher && !run_mesh_benchmark(*world, 20)) {
+            return 1;
+        }
+        return 0;
+    }
+
+    CameraPath bench_path;
+    if (flythrough == "orbit") {
+        bench_path = CameraPath::orbit(glm::vec3(0.0f, static_cast<float>(terrain_max), 0.0f),
+            static_cast<float>(WORLD_SIZE_X) * 0.75f, 30.0f, 20.0f);
+    }
+    else if (!flythrough.empty() && !bench_path.load(flythrough)) {
+        return 1;
+    }
+    const bool benchmark = !bench_path.empty();
+
     Window window(1280, 720, "Voxel Engine");
-    if (!window.init()) {
+    if (!window.init(!benchmark)) {
         return 1;
     }
 
@@ -32,18 +325,18 @@ int main()
     glFrontFace(GL_CCW);
 
     Camera camera;
+    camera.pos.y = static_cast<float>(terrain_max) + 14.0f;
     camera.update_vectors();
 
     CameraController cam_ctrl(camera);
 
     Renderer renderer;
-    if (!renderer.init()) {
+    if (!renderer.init(static_cast<size_t>(staging_mb) * 1024 * 1024)) {
         return 1;
     }
 
-    // World on heap (avoids large stack frame warnings)
-    auto world = std::make_unique<World>();
-    world->fill_terrain_noise_10_16_grass_stone();
+    const std::unique_ptr<World> world = world_job.get();
+    print_world_stats(*world);
 
     const glm::vec3 world_origin(
         -static_cast<float>(WORLD_SIZE_X) * 0.5f,
@@ -51,23 +344,105 @@ int main()
         -static_cast<float>(WORLD_SIZE_Z) * 0.5f
     );
 
-    std::vector<Vertex> verts;
-    std::vector<uint32_t> inds;
-    build_world_mesh(*world, world_origin, verts, inds);
+    // Sections are meshed one at a time and reach the GPU through the upload
+    // scheduler, a few per frame; an empty mesh removes the section
+    UploadScheduler uploads;
+    const auto mesh_section_for_upload = [&](const SectionCoord& c, uint64_t frame) {
+        SectionMesh m;
+        build_section_mesh(*world, c.cx, c.cy, c.cz, world_origin, m.verts, m.inds);
+        m.bounds.min = world_origin + glm::vec3(
+            static_cast<float>(c.cx * CHUNK_X), static_cast<float>(c.cy * CHUNK_Y), static_cast<float>(c.cz * CHUNK_Z));
+        m.bounds.max = m.bounds.min + glm::vec3(static_cast<float>(CHUNK_X), static_cast<float>(CHUNK_Y), static_cast<float>(CHUNK_Z));
+        m.bounds.section = section_key(*world, c.cx, c.cy, c.cz);
+        m.completed = std::chrono::steady_clock::now();
+        m.completed_frame = frame;
+        return m;
+    };
 
-    std::cout << "World mesh: " << verts.size() << " verts, " << inds.size() << " indices\n";
+    MeshStats mesh_stats;
+    size_t mesh_verts = 0;
+    size_t mesh_inds = 0;
+    for (int cz = 0; cz < WORLD_CHUNKS_Z; ++cz) {
+        for (int cx = 0; cx < WORLD_CHUNKS_X; ++cx) {
+            for (int cy = 0; cy < world->chunks_y(); ++cy) {
+                SectionMesh m = mesh_section_for_upload(SectionCoord{ cx, cy, cz }, 0);
+                m.track_latency = false;
+                if (m.inds.empty()) {
+                    ++mesh_stats.sections_skipped;
+                    continue;
+                }
+                ++mesh_stats.sections_meshed;
+                mesh_verts += m.verts.size();
+                mesh_inds += m.inds.size();
+                uploads.submit(std::move(m));
+            }
+        }
+    }
 
-    renderer.upload_mesh(verts, inds);
+    JobPool jobs;
+    OcclusionCuller culler(jobs);
+    std::vector<uint8_t> section_visible;
+    if (occlusion) {
+        std::vector<OccluderBox> occluders;
+        build_occluders(*world, world_origin, occluders);
+        std::cout << "Occlusion: " << occluders.size() << " occluders, " << jobs.size() << " threads\n";
+        culler.set_occluders(std::move(occluders));
+    }
 
-    double last_time = window.time_seconds();
+    std::cout << "World mesh: " << mesh_verts << " verts, " << mesh_inds << " indices in "
+              << mesh_stats.sections_meshed << " sections\n";
 
-    while (!window.should_close()) {
-        const double now = window.time_seconds();
-        const float dt = static_cast<float>(now - last_time);
-        last_time = now;
+    // The first frame starts with the whole world resident
+    {
+        const auto upload = [&](const SectionMesh& m) { return renderer.upload_section(m); };
+        while (!uploads.empty()) {
+            uploads.run(glm::mat4(1.0f), glm::vec3(0.0f), UploadBudget{ 0, 0.0 }, upload);
+            renderer.end_frame();
+            if (uploads.stats().ring_full) glFinish();
+        }
+    }
+
+    std::cout << mem_stats_log_line() << "\n";
+
+    // Sections left unedited for --cold-after frames move to the packed tier
+    std::unique_ptr<ChunkCompressor> compressor;
+    if (cold_after > 0) {
+        compressor = std::make_unique<ChunkCompressor>(*world, static_cast<uint32_t>(cold_after));
+    }
+    const auto age_world = [&] {
+        world->advance_frame();
+        if (compressor) compressor->update();
+    };
+    const auto cold_log_line = [&] {
+        const PackedCacheStats cache = packed_cache_stats();
+        return "cold: " + std::to_string(world->packed_sections()) + " packed, " +
+            std::to_string(world->allocated_sections()) + " hot, " +
+            std::to_string(cache.misses) + " unpacks, max " + std::to_string(cache.max_unpack_us) + " us, cache " +
+            std::to_string(cache.resident) + "/" + std::to_string(cache.capacity) + " sections, " +
+            std::to_string(mem_stats(MemCategory::Caches).bytes / 1024) + " KiB";
+    };
 
-        cam_ctrl.update(window, dt);
+    // Quality starts at the top; only the interactive loop lets the governor lower it
+    const bool governed = target_ms > 0.0;
+    const float world_extent = std::sqrt(static_cast<float>(WORLD_SIZE_X * WORLD_SIZE_X + WORLD_SIZE_Z * WORLD_SIZE_Z) +
+        static_cast<float>(world->size_y()) * static_cast<float>(world->size_y()));
+    QualityGovernor governor(target_ms, world_extent);
+    QualityLevel quality = governor.settings();
 
+    const auto upload_log_line = [&] {
+        const UploadStats& s = uploads.stats();
+        return "uploads: " + std::to_string(s.queued) + " queued (peak " + std::to_string(s.peak_queued) + "), " +
+            std::to_string(s.total_uploaded) + " sections, " + std::to_string(s.total_bytes / 1024) + " KiB, " +
+            std::to_string(s.superseded) + " superseded, " + std::to_string(s.ring_stalls) + " ring stalls, latency " +
+            std::to_string(s.latency_mean_ms) + " ms mean, " + std::to_string(s.latency_p95_ms) + " p95, " +
+            std::to_string(s.latency_max_ms) + " max, " + std::to_string(s.latency_mean_frames) + " frames";
+    };
+
+    // Occluders for remeshed sections still on their way to the GPU
+    std::vector<OccluderBox> pending_occluders;
+    bool occluders_pending = false;
+
+    const auto draw_frame = [&](uint64_t frame) {
         const int fb_w = window.framebuffer_width();
         const int fb_h = window.framebuffer_height();
         const float aspect = (fb_h > 0) ? (static_cast<float>(fb_w) / static_cast<float>(fb_h)) : 1.0f;
@@ -77,14 +452,339 @@ int main()
 
         const glm::mat4 model = glm::mat4(1.0f);
         const glm::mat4 view = camera.view_matrix();
-        const glm::mat4 proj = camera.projection_matrix(aspect, 0.1f, 2000.0f);
+        // Governed: far plane just past the view distance, covering a section's
+        // diagonal. Fixed quality keeps the fixed far plane and no distance cull.
+        const float far_plane = governed ? quality.view_distance + 2.0f * CHUNK_Y : 2000.0f;
+        const glm::mat4 proj = camera.projection_matrix(aspect, 0.1f, far_plane);
 
         const glm::mat4 mvp = proj * view * model;
 
-        renderer.render(mvp);
+        uploads.run(mvp, camera.pos, upload_budget, [&](const SectionMesh& m) { return renderer.upload_section(m); });
+        if (occluders_pending && uploads.empty()) {
+            culler.set_occluders(std::move(pending_occluders));
+            pending_occluders = {};
+            occluders_pending = false;
+        }
 
-        window.swap_buffers();
+        const std::vector<SectionDraw>& section_draws = renderer.section_draws();
+        if (occlusion) {
+            culler.cull(mvp, camera.pos, section_draws, section_visible, occlusion_budget_ms);
+        }
+        else {
+            section_visible.assign(section_draws.size(), 1);
+        }
+        if (governed) cull_by_distance(camera.pos, quality.view_distance, section_draws, section_visible);
+        renderer.render(mvp, section_draws, section_visible);
+        uploads.record_draws(section_draws, section_visible, frame);
+    };
+
+    if (benchmark) {
+        // Fixed simulated timestep: the same path always yields the same frames
+        using clock = std::chrono::steady_clock;
+        constexpr double BENCH_DT = 1.0 / 60.0;
+
+        window.set_vsync(false);
+
+        FrameRecorder recorder;
+        recorder.init();
+
+        const int frame_count = static_cast<int>(std::ceil(bench_path.duration() / BENCH_DT)) + 1;
+        for (int frame = 0; frame < frame_count && !window.should_close(); ++frame) {
+            const auto t0 = clock::now();
+
+            FrameSample sample;
+            sample.frame = frame;
+            sample.sim_time = frame * BENCH_DT;
+
+            bench_path.sample(static_cast<float>(sample.sim_time), camera);
+
+            recorder.begin_gpu();
+            draw_frame(static_cast<uint64_t>(frame));
+            recorder.end_gpu();
+
+            const auto t1 = clock::now();
+            window.swap_buffers();
+            renderer.end_frame();
+            window.poll_events();
+            const auto t2 = clock::now();
+
+            sample.cpu_ms = std::chrono::duration<double, std::milli>(t1 - t0).count();
+            sample.frame_ms = std::chrono::duration<double, std::milli>(t2 - t0).count();
+            sample.draw_calls = renderer.stats().draw_calls;
+            sample.indices = renderer.stats().indices;
+            sample.sections_drawn = renderer.stats().sections_drawn;
+            if (occlusion) {
+                sample.occlusion_culled = culler.stats().occlusion_culled;
+                sample.occlusion_ms = culler.stats().raster_ms + culler.stats().test_ms;
+            }
+
+            // The world is generated and meshed once up front
+            if (frame == 0) {
+                sample.chunk_loads = static_cast<uint32_t>(world->allocated_sections());
+                sample.chunk_meshes = mesh_stats.sections_meshed;
+            }
+
+            recorder.add(sample);
+
+            age_world();
+            chunk_versions_collect();
+        }
+
+        recorder.finish();
+        recorder.print_summary();
+        recorder.write_csv(bench_csv);
+        std::cout << mem_stats_log_line() << "\n" << cold_log_line() << "\n";
+
+        window.shutdown();
+        return 0;
+    }
+
+    // Simulation runs in fixed steps; a replay must use the recorded step
+    InputLog input_log;
+    if (!replay_input.empty()) {
+        if (!input_log.load(replay_input)) {
+            return 1;
+        }
+        sim_hz = 1.0 / input_log.step_seconds();
+    }
+    FixedTimestep timestep(1.0 / sim_hz);
+    input_log.set_step_seconds(timestep.step_seconds());
+
+    FramePacer pacer(frames_ahead);
+
+    TickScheduler tick_scheduler(*world, jobs);
+    FixedTimestep block_clock(1.0 / std::max(tick_hz, 1.0), quality.max_tick_steps);
+
+    if (governed && !governor_log.empty() && !governor.open_log(governor_log)) {
+        return 1;
+    }
+    // Sections waiting to be remeshed; the flags keep each in the queue once
+    std::vector<SectionCoord> remesh_queue;
+    std::vector<uint8_t> remesh_queued;
+    const auto queue_remesh = [&](const std::vector<SectionCoord>& sections) {
+        for (const SectionCoord& c : sections) {
+            const uint32_t key = section_key(*world, c.cx, c.cy, c.cz);
+            if (key >= remesh_queued.size()) remesh_queued.resize(key + 1, 0);
+            if (remesh_queued[key]) continue;
+            remesh_queued[key] = 1;
+            remesh_queue.push_back(c);
+        }
+    };
+    int frames_since_remesh = 0;
+    double last_work_ms = 0.0;
+
+    CameraPath recording;
+    double next_key_time = 0.0;
+    const double record_start = window.time_seconds();
+
+    double last_time = window.time_seconds();
+    double next_mem_log = last_time + mem_log_interval;
+    bool dump_key_was_down = false;
+    bool carve_key_was_down = false;
+    bool undo_key_was_down = false;
+    bool sand_key_was_down = false;
+    bool tank_key_was_down = false;
+    std::vector<WorldSnapshot> undo_history;    // shares unchanged chunks with the live world
+
+    // Frame-time jitter over the session
+    uint64_t frame_count = 0;
+    double frame_ms_sum = 0.0;
+    uint64_t sections_total = 0;
+    uint64_t sections_occluded = 0;
+    uint64_t occlusion_over_budget = 0;
+    double frame_ms_sq_sum = 0.0;
+
+    while (!window.should_close()) {
+        // Wait for the GPU before sampling anything, so input is as fresh as possible
+        pacer.wait();
         window.poll_events();
+
+        const double now = window.time_seconds();
+        const double frame_dt = now - last_time;
+        last_time = now;
+
+        if (frame_count > 0) {
+            frame_ms_sum += frame_dt * 1000.0;
+            frame_ms_sq_sum += frame_dt * frame_dt * 1.0e6;
+        }
+        ++frame_count;
+
+        // Hold the frame budget: background work counts against raising quality
+        if (governed && frame_count > 1) {
+            const size_t backlog = tick_scheduler.active_blocks() + (compressor ? compressor->in_flight() : 0);
+            if (governor.update(frame_dt * 1000.0, last_work_ms, backlog)) {
+                quality = governor.settings();
+                block_clock.set_max_steps(quality.max_tick_steps);
+            }
+        }
+
+        const int steps = timestep.advance(frame_dt);
+        for (int i = 0; i < steps; ++i) {
+            const uint64_t tick = timestep.ticks() - static_cast<uint64_t>(steps - i);
+
+            MoveInput in;
+            if (!replay_input.empty()) {
+                if (tick >= input_log.size()) {
+                    window.set_should_close(true);
+                    break;
+                }
+                in = input_log.at(tick);
+            }
+            else {
+                in = cam_ctrl.sample_input(window);
+                if (!record_input.empty()) input_log.add(in);
+            }
+            cam_ctrl.step(in, static_cast<float>(timestep.step_seconds()));
+        }
+
+        if (mem_log_interval > 0.0 && now >= next_mem_log) {
+            std::cout << mem_stats_log_line() << "\n" << cold_log_line() << "\n" << upload_log_line() << "\n"
+                      << "ticks: " << tick_scheduler.active_blocks() << " active, "
+                      << tick_scheduler.delayed_blocks() << " delayed, last " << tick_scheduler.stats().ms << " ms\n";
+            next_mem_log = now + mem_log_interval;
+        }
+
+        // F2: dump memory stats as JSON
+        const bool dump_key_down = window.key_down(GLFW_KEY_F2);
+        if (dump_key_down && !dump_key_was_down && mem_stats_write_json("memory_stats.json")) {
+            std::cout << "Wrote memory_stats.json\n";
+        }
+        dump_key_was_down = dump_key_down;
+
+        // F3: carve a sphere 12 blocks ahead of the camera
+        const bool carve_key_down = window.key_down(GLFW_KEY_F3);
+        if (carve_key_down && !carve_key_was_down) {
+            const glm::vec3 p = cam_ctrl.sim_position() + camera.front * 12.0f - world_origin;
+            undo_history.push_back(world->snapshot());
+            fill_sphere(*world, p.x, p.y, p.z, 6.0f, BlockType::Air);
+        }
+        carve_key_was_down = carve_key_down;
+
+        // F4: undo the last carve
+        const bool undo_key_down = window.key_down(GLFW_KEY_F4);
+        if (undo_key_down && !undo_key_was_down && !undo_history.empty()) {
+            world->restore(undo_history.back());
+            undo_history.pop_back();
+        }
+        undo_key_was_down = undo_key_down;
+
+        // F5: drop a block of sand 12 blocks ahead of the camera
+        const bool sand_key_down = window.key_down(GLFW_KEY_F5);
+        if (sand_key_down && !sand_key_was_down) {
+            const glm::vec3 p = cam_ctrl.sim_position() + camera.front * 12.0f - world_origin;
+            const int x = static_cast<int>(std::floor(p.x));
+            const int y = static_cast<int>(std::floor(p.y));
+            const int z = static_cast<int>(std::floor(p.z));
+            fill_box(*world, BlockBox{ x - 1, y - 1, z - 1, x + 2, y + 3, z + 2 }, BlockType::Sand);
+        }
+        sand_key_was_down = sand_key_down;
+
+        // F6: build a glass tank of water with a leaf canopy ahead of the camera
+        const bool tank_key_down = window.key_down(GLFW_KEY_F6);
+        if (tank_key_down && !tank_key_was_down) {
+            const glm::vec3 p = cam_ctrl.sim_position() + camera.front * 16.0f - world_origin;
+            const int x = static_cast<int>(std::floor(p.x));
+            const int y = static_cast<int>(std::floor(p.y));
+            const int z = static_cast<int>(std::floor(p.z));
+            fill_box(*world, BlockBox{ x - 3, y - 2, z - 3, x + 4, y + 3, z + 4 }, BlockType::Glass);
+            fill_box(*world, BlockBox{ x - 2, y - 1, z - 2, x + 3, y + 3, z + 3 }, BlockType::Water);
+            fill_box(*world, BlockBox{ x - 4, y + 3, z - 4, x + 5, y + 5, z + 5 }, BlockType::Leaves);
+        }
+        tank_key_was_down = tank_key_down;
+
+        // Blocks around this frame's edits may start to fall or spread. The
+        // dirty list holds only edits here: tick changes are taken below.
+        if (world->has_dirty_sections()) {
+            const std::vector<SectionCoord> edited = world->take_dirty_sections();
+            queue_remesh(edited);
+            tick_scheduler.wake_sections(edited);
+        }
+
+        if (tick_hz > 0.0) {
+            const int block_steps = block_clock.advance(frame_dt);
+            for (int i = 0; i < block_steps; ++i) {
+                tick_scheduler.tick();
+            }
+        }
+
+        // Ticks keep their own blocks active; what they changed only needs remeshing
+        queue_remesh(world->take_dirty_sections());
+
+        age_world();
+
+        // Edits only mark sections dirty; those are remeshed at most once per
+        // frame, or less often when the governor lowers quality, and uploaded
+        // over the next frames as the budget allows
+        ++frames_since_remesh;
+        if (!remesh_queue.empty() && frames_since_remesh >= quality.remesh_interval) {
+            frames_since_remesh = 0;
+            for (const SectionCoord& c : remesh_queue) {
+                remesh_queued[section_key(*world, c.cx, c.cy, c.cz)] = 0;
+                uploads.submit(mesh_section_for_upload(c, frame_count));
+            }
+            remesh_queue.clear();
+
+            // Built from the world these meshes came from, but installed only
+            // once they are all resident: a new solid block must not cull what
+            // is behind it before its own mesh is drawn
+            if (occlusion) {
+                pending_occluders.clear();
+                build_occluders(*world, world_origin, pending_occluders);
+                occluders_pending = true;
+            }
+        }
+
+        // Free chunk versions replaced by edits once no reader can see them
+        chunk_versions_collect();
+
+        // Late latch: pick up mouse motion that arrived during this frame's
+        // work, then place the camera between the last two simulated states
+        if (replay_input.empty()) {
+            window.poll_events();
+            cam_ctrl.apply_look(window);
+        }
+        cam_ctrl.interpolate(timestep.alpha());
+
+        // --record-path: sample the live camera every 100 ms for later replay
+        if (!record_path.empty() && now - record_start >= next_key_time) {
+            recording.add_key(CameraKey{ static_cast<float>(now - record_start), camera.pos, camera.yaw, camera.pitch });
+            next_key_time += 0.1;
+        }
+
+        draw_frame(frame_count);
+        if (occlusion) {
+            sections_total += culler.stats().sections_tested;
+            sections_occluded += culler.stats().occlusion_culled;
+            occlusion_over_budget += culler.stats().over_budget ? 1 : 0;
+        }
+        last_work_ms = (window.time_seconds() - now) * 1000.0;
+
+        window.swap_buffers();
+        renderer.end_frame();
+        pacer.end_frame();
+    }
+
+    if (frame_count > 1) {
+        const double n = static_cast<double>(frame_count - 1);
+        const double mean = frame_ms_sum / n;
+        const double jitter = std::sqrt(std::max(frame_ms_sq_sum / n - mean * mean, 0.0));
+        const glm::vec3 p = cam_ctrl.sim_position();
+        std::cout << "Frames: " << frame_count << ", mean " << mean << " ms, jitter (stddev) " << jitter << " ms\n"
+                  << "Simulation: " << timestep.ticks() << " ticks at " << sim_hz << " Hz, final position "
+                  << p.x << ' ' << p.y << ' ' << p.z << "\n";
+        if (occlusion) {
+            std::cout << "Occlusion: " << sections_occluded << " of " << sections_total
+                      << " section tests culled, " << occlusion_over_budget << " frames over budget\n";
+        }
+        std::cout << upload_log_line() << "\n";
+    }
+
+    if (!record_input.empty() && replay_input.empty()) {
+        input_log.save(record_input);
+    }
+
+    if (!record_path.empty()) {
+        recording.save(record_path);
     }
 
     window.shutdown();
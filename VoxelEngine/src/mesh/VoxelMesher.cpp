@@ -1,19 +1,13 @@
 #include "mesh/VoxelMesher.h"
+#include "world/BlockRegistry.h"
 
 #include <algorithm>
+#include <array>
+#include <bit>
+#include <cstring>
 
-uint32_t tex_layer_for_block(BlockType t)
-{
-    // texture array layers: 0 = grass, 1 = stone
-    switch (t) {
-    case BlockType::Grass: return 0;
-    case BlockType::Stone: return 1;
-    default:               return 1;
-    }
-}
-
-static void emit_face(std::vector<Vertex>& out_verts,
-    std::vector<uint32_t>& out_inds,
+static void emit_face(MeshVertices& out_verts,
+    MeshIndices& out_inds,
     const glm::vec3& a,
     const glm::vec3& b,
     const glm::vec3& c,
@@ -42,43 +36,387 @@ static void emit_face(std::vector<Vertex>& out_verts,
     out_inds.push_back(base + 0);
 }
 
-void build_world_mesh(const World& world,
+static void emit_block_face(MeshVertices& out_verts,
+    MeshIndices& out_inds,
+    int face,
+    int gx, int gy, int gz,
     const glm::vec3& world_origin,
-    std::vector<Vertex>& out_verts,
-    std::vector<uint32_t>& out_inds)
+    uint32_t layer)
+{
+    const float fx = static_cast<float>(gx) + world_origin.x;
+    const float fy = static_cast<float>(gy) + world_origin.y;
+    const float fz = static_cast<float>(gz) + world_origin.z;
+
+    const glm::vec3 p000(fx, fy, fz);
+    const glm::vec3 p100(fx + 1, fy, fz);
+    const glm::vec3 p010(fx, fy + 1, fz);
+    const glm::vec3 p110(fx + 1, fy + 1, fz);
+
+    const glm::vec3 p001(fx, fy, fz + 1);
+    const glm::vec3 p101(fx + 1, fy, fz + 1);
+    const glm::vec3 p011(fx, fy + 1, fz + 1);
+    const glm::vec3 p111(fx + 1, fy + 1, fz + 1);
+
+    switch (face) {
+    case FACE_POS_X: emit_face(out_verts, out_inds, p101, p100, p110, p111, glm::vec3(1, 0, 0), layer); break;
+    case FACE_NEG_X: emit_face(out_verts, out_inds, p000, p001, p011, p010, glm::vec3(-1, 0, 0), layer); break;
+    case FACE_POS_Y: emit_face(out_verts, out_inds, p011, p111, p110, p010, glm::vec3(0, 1, 0), layer); break;
+    case FACE_NEG_Y: emit_face(out_verts, out_inds, p000, p100, p101, p001, glm::vec3(0, -1, 0), layer); break;
+    case FACE_POS_Z: emit_face(out_verts, out_inds, p001, p101, p111, p011, glm::vec3(0, 0, 1), layer); break;
+    case FACE_NEG_Z: emit_face(out_verts, out_inds, p100, p000, p010, p110, glm::vec3(0, 0, -1), layer); break;
+    default: break;
+    }
+}
+
+// Reference path: one voxel at a time, six get_global lookups per drawn block.
+static void mesh_section_reference(const World& world,
+    int cx, int cy, int cz,
+    const glm::vec3& world_origin,
+    MeshVertices& out_verts,
+    MeshIndices& out_inds)
+{
+    const int x0 = cx * CHUNK_X;
+    const int y0 = cy * CHUNK_Y;
+    const int z0 = cz * CHUNK_Z;
+
+    // Walk in storage order so neighbor reads follow the chunk layout.
+    Chunk::for_each_voxel([&](int lx, int ly, int lz) {
+        const int gx = x0 + lx;
+        const int gy = y0 + ly;
+        const int gz = z0 + lz;
+
+        const BlockType bt = world.get_global(gx, gy, gz);
+        if (bt == BlockType::Air) return;
+
+        const auto face = [&](int f, int nx, int ny, int nz) {
+            if (block_face_visible(bt, world.get_global(nx, ny, nz))) {
+                emit_block_face(out_verts, out_inds, f, gx, gy, gz, world_origin, block_face_layer(bt, f));
+            }
+        };
+        face(FACE_POS_X, gx + 1, gy, gz);
+        face(FACE_NEG_X, gx - 1, gy, gz);
+        face(FACE_POS_Y, gx, gy + 1, gz);
+        face(FACE_NEG_Y, gx, gy - 1, gz);
+        face(FACE_POS_Z, gx, gy, gz + 1);
+        face(FACE_NEG_Z, gx, gy, gz - 1);
+    });
+}
+
+// Occupancy of a section plus a one-voxel border, one word per x-row:
+// bit 0 is x = -1, bits 1..16 are x = 0..15, bit 17 is x = 16. `opaque`
+// holds opaque blocks; groups[g - 1] the transparent blocks of cull group g,
+// built only when the section or its border has any.
+struct SectionMask
+{
+    static constexpr int ROWS_Y = CHUNK_Y + 2;
+    static constexpr int ROWS_Z = CHUNK_Z + 2;
+    static constexpr int ROWS = ROWS_Y * ROWS_Z;
+
+    // Edge rows (y and z both in the border) are left unset: never read
+    std::array<uint32_t, ROWS> opaque;
+    std::array<std::array<uint32_t, ROWS>, BLOCK_CULL_GROUPS> groups;
+    bool transparent = false;
+
+    static constexpr int row(int y, int z) { return (y + 1) + ROWS_Y * (z + 1); }
+};
+
+using RowGroups = std::array<uint32_t, BLOCK_CULL_GROUPS>;
+
+static constexpr uint32_t ROW_BITS = (1u << CHUNK_X) - 1u;
+static constexpr uint32_t INTERIOR_BITS = ROW_BITS << 1;
+
+static constexpr std::array<uint8_t, BLOCK_CULL_GROUPS> TRANSPARENT_IDS = [] {
+    std::array<uint8_t, BLOCK_CULL_GROUPS> ids{};
+    for (int b = 0; b < 256; ++b) {
+        if (BLOCK_TABLES.cull_group[b]) ids[BLOCK_TABLES.cull_group[b] - 1] = static_cast<uint8_t>(b);
+    }
+    return ids;
+}();
+
+// Row tests on 8 blocks at a time (contiguous x-rows only): byte i of a word
+// is voxel x = i. The masks below keep the high bit of each selected byte.
+static constexpr uint64_t BYTES_ONE = 0x0101010101010101ull;
+static constexpr uint64_t BYTES_LOW7 = 0x7F7F7F7F7F7F7F7Full;
+
+static uint64_t nonzero_bytes(uint64_t w)
+{
+    return (((w & BYTES_LOW7) + BYTES_LOW7) | w) & ~BYTES_LOW7;
+}
+
+static uint64_t transparent_bytes(uint64_t w)
+{
+    uint64_t m = 0;
+    for (uint8_t id : TRANSPARENT_IDS) m |= ~nonzero_bytes(w ^ (id * BYTES_ONE)) & ~BYTES_LOW7;
+    return m;
+}
+
+// Byte high bits to one bit per byte (byte i -> bit i).
+static uint32_t pack_byte_bits(uint64_t m)
+{
+    return static_cast<uint32_t>(((m >> 7) * 0x0102040810204080ull) >> 56);
+}
+
+static bool in_world(const World& world, int cx, int cy, int cz)
+{
+    return cx >= 0 && cx < WORLD_CHUNKS_X &&
+        cy >= 0 && cy < world.chunks_y() &&
+        cz >= 0 && cz < WORLD_CHUNKS_Z;
+}
+
+// Opaque bits (bit x = voxel x) of local row (ly, lz) in section (cx, cy, cz);
+// sections outside the world read as air. Flags rows holding transparent
+// blocks in `transparent`.
+static uint32_t section_row_bits(const World& world, int cx, int cy, int cz, int ly, int lz, bool& transparent)
+{
+    if (!in_world(world, cx, cy, cz)) return 0;
+
+    const ChunkSection& sec = world.section_at(cx, cy, cz);
+    if (sec.is_uniform()) {
+        transparent |= block_cull_group(sec.fill()) != 0;
+        return block_opaque(sec.fill()) ? ROW_BITS : 0u;
+    }
+
+    const ChunkVersion* c = sec.chunk();
+    uint32_t filled = 0;
+    uint32_t clear = 0;
+    if constexpr (ChunkLayout::CONTIGUOUS_X && std::endian::native == std::endian::little) {
+        std::array<uint64_t, CHUNK_X / 8> words;
+        std::memcpy(words.data(), &c->blocks[Chunk::idx(0, ly, lz)], sizeof(words));
+        for (size_t i = 0; i < words.size(); ++i) {
+            filled |= pack_byte_bits(nonzero_bytes(words[i])) << (8 * i);
+            clear |= pack_byte_bits(transparent_bytes(words[i])) << (8 * i);
+        }
+    }
+    else {
+        for (int x = 0; x < CHUNK_X; ++x) {
+            const uint8_t b = c->blocks[Chunk::idx(x, ly, lz)];
+            filled |= static_cast<uint32_t>(b != 0) << x;
+            clear |= static_cast<uint32_t>(block_cull_group(static_cast<BlockType>(b)) != 0) << x;
+        }
+    }
+    transparent |= clear != 0;
+    return filled & ~clear;
+}
+
+// Per-group bits of the same row (index g - 1 for cull group g).
+static RowGroups section_row_groups(const World& world, int cx, int cy, int cz, int ly, int lz)
+{
+    RowGroups groups{};
+    if (!in_world(world, cx, cy, cz)) return groups;
+
+    const ChunkSection& sec = world.section_at(cx, cy, cz);
+    if (sec.is_uniform()) {
+        const uint8_t g = block_cull_group(sec.fill());
+        if (g) groups[g - 1] = ROW_BITS;
+        return groups;
+    }
+
+    const ChunkVersion* c = sec.chunk();
+    for (int x = 0; x < CHUNK_X; ++x) {
+        const uint8_t g = BLOCK_TABLES.cull_group[c->blocks[Chunk::idx(x, ly, lz)]];
+        if (g) groups[g - 1] |= 1u << x;
+    }
+    return groups;
+}
+
+// Calls f(y, z, ly, lz, ncy, ncz, pad_x) for every mask row the culling pass reads.
+template <typename F>
+static void for_each_mask_row(int cy, int cz, F&& f)
+{
+    for (int z = -1; z <= CHUNK_Z; ++z) {
+        for (int y = -1; y <= CHUNK_Y; ++y) {
+            const bool y_border = (y < 0 || y >= CHUNK_Y);
+            const bool z_border = (z < 0 || z >= CHUNK_Z);
+
+            // Edge rows are never read by the culling pass.
+            if (y_border && z_border) continue;
+
+            const int ncy = cy + (y < 0 ? -1 : (y >= CHUNK_Y ? 1 : 0));
+            const int ncz = cz + (z < 0 ? -1 : (z >= CHUNK_Z ? 1 : 0));
+            const int ly = (y + CHUNK_Y) % CHUNK_Y;
+            const int lz = (z + CHUNK_Z) % CHUNK_Z;
+
+            // x padding is only needed for interior rows (the +-x pass).
+            f(y, z, ly, lz, ncy, ncz, !y_border && !z_border);
+        }
+    }
+}
+
+static void build_section_mask(const World& world, int cx, int cy, int cz, SectionMask& mask)
+{
+    bool transparent = false;
+    for_each_mask_row(cy, cz, [&](int y, int z, int ly, int lz, int ncy, int ncz, bool pad_x) {
+        uint32_t bits = section_row_bits(world, cx, ncy, ncz, ly, lz, transparent) << 1;
+        if (pad_x) {
+            bits |= (section_row_bits(world, cx - 1, cy, cz, ly, lz, transparent) >> (CHUNK_X - 1)) & 1u;
+            bits |= (section_row_bits(world, cx + 1, cy, cz, ly, lz, transparent) & 1u) << (CHUNK_X + 1);
+        }
+        mask.opaque[SectionMask::row(y, z)] = bits;
+    });
+
+    // Transparent blocks are rare; the group planes cost a second pass only when present
+    mask.transparent = transparent;
+    if (!transparent) return;
+
+    for_each_mask_row(cy, cz, [&](int y, int z, int ly, int lz, int ncy, int ncz, bool pad_x) {
+        RowGroups bits = section_row_groups(world, cx, ncy, ncz, ly, lz);
+        for (uint32_t& b : bits) b <<= 1;
+        if (pad_x) {
+            const RowGroups lo = section_row_groups(world, cx - 1, cy, cz, ly, lz);
+            const RowGroups hi = section_row_groups(world, cx + 1, cy, cz, ly, lz);
+            for (int g = 0; g < BLOCK_CULL_GROUPS; ++g) {
+                bits[g] |= (lo[g] >> (CHUNK_X - 1)) & 1u;
+                bits[g] |= (hi[g] & 1u) << (CHUNK_X + 1);
+            }
+        }
+        for (int g = 0; g < BLOCK_CULL_GROUPS; ++g) {
+            mask.groups[g][SectionMask::row(y, z)] = bits[g];
+        }
+    });
+}
+
+// Culls a whole 16-voxel row per direction with shift/AND-NOT, then emits the
+// surviving faces by walking set bits. A face survives unless its neighbor is
+// opaque or both blocks are in the same transparent group.
+static void mesh_section(const World& world,
+    int cx, int cy, int cz,
+    const glm::vec3& world_origin,
+    MeshVertices& out_verts,
+    MeshIndices& out_inds)
+{
+    SectionMask mask;
+    build_section_mask(world, cx, cy, cz, mask);
+
+    const ChunkSection& sec = world.section_at(cx, cy, cz);
+
+    const int x0 = cx * CHUNK_X;
+    const int y0 = cy * CHUNK_Y;
+    const int z0 = cz * CHUNK_Z;
+
+    const auto& opaque = mask.opaque;
+
+    for (int z = 0; z < CHUNK_Z; ++z) {
+        for (int y = 0; y < CHUNK_Y; ++y) {
+            const int r = SectionMask::row(y, z);
+
+            uint32_t filled = opaque[r];
+            if (mask.transparent) {
+                for (const auto& group : mask.groups) filled |= group[r];
+            }
+            filled &= INTERIOR_BITS;
+            if (!filled) continue;
+
+            const uint32_t o = opaque[r];
+            std::array<uint32_t, FACE_COUNT> visible{};
+            visible[FACE_POS_X] = filled & ~(o >> 1);
+            visible[FACE_NEG_X] = filled & ~(o << 1);
+            visible[FACE_POS_Y] = filled & ~opaque[SectionMask::row(y + 1, z)];
+            visible[FACE_NEG_Y] = filled & ~opaque[SectionMask::row(y - 1, z)];
+            visible[FACE_POS_Z] = filled & ~opaque[SectionMask::row(y, z + 1)];
+            visible[FACE_NEG_Z] = filled & ~opaque[SectionMask::row(y, z - 1)];
+
+            if (mask.transparent) {
+                for (const auto& group : mask.groups) {
+                    const uint32_t t = group[r];
+                    if (!(t & INTERIOR_BITS)) continue;
+                    visible[FACE_POS_X] &= ~(t & (t >> 1));
+                    visible[FACE_NEG_X] &= ~(t & (t << 1));
+                    visible[FACE_POS_Y] &= ~(t & group[SectionMask::row(y + 1, z)]);
+                    visible[FACE_NEG_Y] &= ~(t & group[SectionMask::row(y - 1, z)]);
+                    visible[FACE_POS_Z] &= ~(t & group[SectionMask::row(y, z + 1)]);
+                    visible[FACE_NEG_Z] &= ~(t & group[SectionMask::row(y, z - 1)]);
+                }
+            }
+
+            for (int face = 0; face < FACE_COUNT; ++face) {
+                uint32_t bits = visible[face];
+                while (bits) {
+                    const int x = std::countr_zero(bits) - 1;
+                    bits &= bits - 1;
+
+                    const uint32_t layer = block_face_layer(sec.get_local(x, y, z), face);
+                    emit_block_face(out_verts, out_inds, face, x0 + x, y0 + y, z0 + z, world_origin, layer);
+                }
+            }
+        }
+    }
+}
+
+using SectionMesher = void (*)(const World&, int, int, int, const glm::vec3&, MeshVertices&, MeshIndices&);
+
+static void mesh_world_sections(const World& world,
+    const glm::vec3& world_origin,
+    MeshVertices& out_verts,
+    MeshIndices& out_inds,
+    SectionMesher mesher,
+    MeshStats* stats,
+    std::vector<SectionDraw>* draws)
 {
     out_verts.clear();
     out_inds.clear();
+    if (draws) draws->clear();
 
-    for (int gz = 0; gz < WORLD_SIZE_Z; ++gz) {
-        for (int gy = 0; gy < WORLD_SIZE_Y; ++gy) {
-            for (int gx = 0; gx < WORLD_SIZE_X; ++gx) {
-                const BlockType bt = world.get_global(gx, gy, gz);
-                if (bt == BlockType::Air) continue;
-
-                const uint32_t layer = tex_layer_for_block(bt);
-
-                const float fx = static_cast<float>(gx) + world_origin.x;
-                const float fy = static_cast<float>(gy) + world_origin.y;
-                const float fz = static_cast<float>(gz) + world_origin.z;
-
-                const glm::vec3 p000(fx, fy, fz);
-                const glm::vec3 p100(fx + 1, fy, fz);
-                const glm::vec3 p010(fx, fy + 1, fz);
-                const glm::vec3 p110(fx + 1, fy + 1, fz);
-
-                const glm::vec3 p001(fx, fy, fz + 1);
-                const glm::vec3 p101(fx + 1, fy, fz + 1);
-                const glm::vec3 p011(fx, fy + 1, fz + 1);
-                const glm::vec3 p111(fx + 1, fy + 1, fz + 1);
-
-                if (world.get_global(gx + 1, gy, gz) == BlockType::Air) emit_face(out_verts, out_inds, p101, p100, p110, p111, glm::vec3(1, 0, 0), layer);
-                if (world.get_global(gx - 1, gy, gz) == BlockType::Air) emit_face(out_verts, out_inds, p000, p001, p011, p010, glm::vec3(-1, 0, 0), layer);
-                if (world.get_global(gx, gy + 1, gz) == BlockType::Air) emit_face(out_verts, out_inds, p011, p111, p110, p010, glm::vec3(0, 1, 0), layer);
-                if (world.get_global(gx, gy - 1, gz) == BlockType::Air) emit_face(out_verts, out_inds, p000, p100, p101, p001, glm::vec3(0, -1, 0), layer);
-                if (world.get_global(gx, gy, gz + 1) == BlockType::Air) emit_face(out_verts, out_inds, p001, p101, p111, p011, glm::vec3(0, 0, 1), layer);
-                if (world.get_global(gx, gy, gz - 1) == BlockType::Air) emit_face(out_verts, out_inds, p100, p000, p010, p110, glm::vec3(0, 0, -1), layer);
+    MeshStats local;
+
+    for (int cz = 0; cz < WORLD_CHUNKS_Z; ++cz) {
+        for (int cx = 0; cx < WORLD_CHUNKS_X; ++cx) {
+            const ChunkColumn& col = world.column_at(cx, cz);
+
+            // Sections above top_section are all air.
+            for (int cy = 0; cy <= col.top_section; ++cy) {
+                if (col.sections[cy].is_empty() || world.section_buried(cx, cy, cz)) {
+                    ++local.sections_skipped;
+                    continue;
+                }
+
+                const size_t first = out_inds.size();
+                mesher(world, cx, cy, cz, world_origin, out_verts, out_inds);
+                ++local.sections_meshed;
+
+                if (draws && out_inds.size() > first) {
+                    SectionDraw d;
+                    d.min = world_origin + glm::vec3(static_cast<float>(cx * CHUNK_X), static_cast<float>(cy * CHUNK_Y), static_cast<float>(cz * CHUNK_Z));
+                    d.max = d.min + glm::vec3(static_cast<float>(CHUNK_X), static_cast<float>(CHUNK_Y), static_cast<float>(CHUNK_Z));
+                    d.first_index = static_cast<uint32_t>(first);
+                    d.index_count = static_cast<uint32_t>(out_inds.size() - first);
+                    d.section = section_key(world, cx, cy, cz);
+                    draws->push_back(d);
+                }
             }
         }
     }
+
+    if (stats) *stats = local;
+}
+
+void build_world_mesh(const World& world,
+    const glm::vec3& world_origin,
+    MeshVertices& out_verts,
+    MeshIndices& out_inds,
+    MeshStats* stats,
+    std::vector<SectionDraw>* draws)
+{
+    mesh_world_sections(world, world_origin, out_verts, out_inds, &mesh_section, stats, draws);
+}
+
+bool build_section_mesh(const World& world,
+    int cx, int cy, int cz,
+    const glm::vec3& world_origin,
+    MeshVertices& out_verts,
+    MeshIndices& out_inds)
+{
+    out_verts.clear();
+    out_inds.clear();
+    if (world.section_at(cx, cy, cz).is_empty() || world.section_buried(cx, cy, cz)) return false;
+
+    mesh_section(world, cx, cy, cz, world_origin, out_verts, out_inds);
+    return true;
+}
+
+void build_world_mesh_reference(const World& world,
+    const glm::vec3& world_origin,
+    MeshVertices& out_verts,
+    MeshIndices& out_inds)
+{
+    mesh_world_sections(world, world_origin, out_verts, out_inds, &mesh_section_reference, nullptr, nullptr);
 }
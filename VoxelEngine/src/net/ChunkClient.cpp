@@ -0,0 +1,210 @@
+#include "net/ChunkClient.h"
+#include "net/ChunkProtocol.h"
+
+#include <algorithm>
+#include <iostream>
+
+namespace {
+
+constexpr size_t RECV_CHUNK = 64 * 1024;
+
+} // namespace
+
+ChunkClient::~ChunkClient()
+{
+    disconnect();
+}
+
+bool ChunkClient::connect(const std::string& path)
+{
+    disconnect();
+    m_socket = socket_connect_local(path);
+    return connected();
+}
+
+void ChunkClient::disconnect()
+{
+    socket_close(m_socket);
+    m_socket = INVALID_SOCKET_HANDLE;
+}
+
+void ChunkClient::set_view(float x, float y, float z, int radius)
+{
+    MessageWriter w(m_out, MessageType::View);
+    w.f32(x);
+    w.f32(y);
+    w.f32(z);
+    w.u8(static_cast<uint8_t>(std::min(radius, 255)));
+}
+
+bool ChunkClient::valid_section(int cx, int cy, int cz) const
+{
+    return m_world && cx < WORLD_CHUNKS_X && cy < m_world->chunks_y() && cz < WORLD_CHUNKS_Z;
+}
+
+void ChunkClient::mark_around(int cx, int cy, int cz)
+{
+    m_world->mark_section_dirty(cx, cy, cz);
+    m_world->mark_section_dirty(cx - 1, cy, cz);
+    m_world->mark_section_dirty(cx + 1, cy, cz);
+    m_world->mark_section_dirty(cx, cy - 1, cz);
+    m_world->mark_section_dirty(cx, cy + 1, cz);
+    m_world->mark_section_dirty(cx, cy, cz - 1);
+    m_world->mark_section_dirty(cx, cy, cz + 1);
+}
+
+bool ChunkClient::apply_section(const uint8_t* payload, size_t size)
+{
+    MessageReader r(payload, size);
+    const int cx = r.u8();
+    const int cy = r.u8();
+    const int cz = r.u8();
+    if (r.failed || !valid_section(cx, cy, cz)) return false;
+
+    uint8_t blocks[CHUNK_VOLUME];
+    if (!read_section_blocks(r, blocks)) return false;
+
+    ChunkVersion* edit = m_world->begin_section_edit(cx, cy, cz);
+    chunk_from_canonical(*edit, blocks);
+    m_world->commit_section_edit(cx, cy, cz, edit, true);
+    m_world->update_top_section(cx, cz);
+    mark_around(cx, cy, cz);
+
+    ++m_stats.sections;
+    return true;
+}
+
+bool ChunkClient::apply_tick(const uint8_t* payload, size_t size)
+{
+    MessageReader r(payload, size);
+    const uint64_t tick = r.u64();
+    const uint64_t sections = r.varint();
+
+    for (uint64_t s = 0; s < sections && !r.failed; ++s) {
+        const int cx = r.u8();
+        const int cy = r.u8();
+        const int cz = r.u8();
+        const uint64_t count = r.varint();
+        if (r.failed || !valid_section(cx, cy, cz) || count > CHUNK_VOLUME) return false;
+
+        ChunkVersion* edit = m_world->begin_section_edit(cx, cy, cz);
+        bool border = false;
+        uint64_t pos = 0;
+        for (uint64_t i = 0; i < count; ++i) {
+            pos += r.varint();
+            const uint8_t b = r.u8();
+            if (r.failed || pos >= CHUNK_VOLUME) {
+                delete edit;    // never published
+                return false;
+            }
+            const int x = static_cast<int>(pos & 15);
+            const int y = static_cast<int>((pos >> 4) & 15);
+            const int z = static_cast<int>(pos >> 8);
+            edit->set_local(x, y, z, static_cast<BlockType>(b));
+            border = border || x == 0 || x == 15 || y == 0 || y == 15 || z == 0 || z == 15;
+        }
+        m_world->commit_section_edit(cx, cy, cz, edit);
+        m_world->update_top_section(cx, cz);
+        if (border) mark_around(cx, cy, cz);
+        else m_world->mark_section_dirty(cx, cy, cz);
+
+        m_stats.delta_blocks += count;
+    }
+    if (r.failed) return false;
+
+    // A large tick arrives split over several messages
+    if (m_stats.ticks == 0 || tick != m_stats.last_tick) ++m_stats.ticks;
+    m_stats.last_tick = tick;
+    return true;
+}
+
+bool ChunkClient::handle_message(uint8_t type, const uint8_t* payload, size_t size)
+{
+    switch (static_cast<MessageType>(type)) {
+    case MessageType::Hello: {
+        MessageReader r(payload, size);
+        const uint32_t version = r.u32();
+        const int chunks_x = r.u8();
+        const int chunks_y = r.u8();
+        const int chunks_z = r.u8();
+        if (r.failed || version != CHUNK_PROTOCOL_VERSION || chunks_x != WORLD_CHUNKS_X || chunks_z != WORLD_CHUNKS_Z ||
+            chunks_y < 1 || chunks_y > MAX_WORLD_CHUNKS_Y) {
+            std::cerr << "Chunk client: incompatible server (protocol " << version << ")\n";
+            return false;
+        }
+        m_world = std::make_unique<World>(chunks_y);
+        return true;
+    }
+    case MessageType::Section:
+        return apply_section(payload, size);
+    case MessageType::Unload: {
+        MessageReader r(payload, size);
+        const int cx = r.u8();
+        const int cy = r.u8();
+        const int cz = r.u8();
+        if (r.failed || !valid_section(cx, cy, cz)) return false;
+        m_world->set_section_uniform(cx, cy, cz, BlockType::Air);
+        m_world->update_top_section(cx, cz);
+        ++m_stats.unloads;
+        return true;
+    }
+    case MessageType::Tick:
+        return apply_tick(payload, size);
+    default:
+        return false;
+    }
+}
+
+bool ChunkClient::poll()
+{
+    if (!connected()) return false;
+
+    size_t sent = 0;
+    while (sent < m_out.size()) {
+        const long n = socket_send(m_socket, m_out.data() + sent, m_out.size() - sent);
+        if (n < 0) {
+            disconnect();
+            return false;
+        }
+        if (n == 0) break;
+        sent += static_cast<size_t>(n);
+    }
+    m_out.erase(m_out.begin(), m_out.begin() + static_cast<std::ptrdiff_t>(sent));
+
+    uint8_t buf[RECV_CHUNK];
+    bool ok = true;
+    for (;;) {
+        const long n = socket_recv(m_socket, buf, sizeof(buf));
+        if (n < 0) {
+            ok = false;
+            break;
+        }
+        if (n == 0) break;
+        m_in.insert(m_in.end(), buf, buf + n);
+        m_stats.bytes_received += static_cast<uint64_t>(n);
+    }
+
+    size_t pos = 0;
+    while (ok && m_in.size() - pos >= MESSAGE_HEADER_BYTES) {
+        MessageReader header(m_in.data() + pos, MESSAGE_HEADER_BYTES);
+        const uint8_t type = header.u8();
+        const uint32_t size = header.u32();
+        if (size > MAX_MESSAGE_BYTES) {
+            ok = false;
+            break;
+        }
+        if (m_in.size() - pos - MESSAGE_HEADER_BYTES < size) break;
+
+        // Everything but Hello needs the mirror Hello creates
+        if ((!m_world && static_cast<MessageType>(type) != MessageType::Hello) ||
+            !handle_message(type, m_in.data() + pos + MESSAGE_HEADER_BYTES, size)) {
+            ok = false;
+            break;
+        }
+        pos += MESSAGE_HEADER_BYTES + size;
+    }
+    m_in.erase(m_in.begin(), m_in.begin() + static_cast<std::ptrdiff_t>(pos));
+
+    if (!ok) disconnect();
+    return ok;
+}
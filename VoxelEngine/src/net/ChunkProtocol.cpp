@@ -0,0 +1,182 @@
+#include "net/ChunkProtocol.h"
+
+#include <cmath>
+#include <cstring>
+
+bool section_in_view(const SectionCoord& s, float x, float y, float z, int radius)
+{
+    const float dx = (static_cast<float>(s.cx) + 0.5f) * CHUNK_X - x;
+    const float dy = (static_cast<float>(s.cy) + 0.5f) * CHUNK_Y - y;
+    const float dz = (static_cast<float>(s.cz) + 0.5f) * CHUNK_Z - z;
+    const float r = static_cast<float>(radius) * CHUNK_X;
+    return dx * dx + dy * dy + dz * dz <= r * r;
+}
+
+MessageWriter::MessageWriter(std::vector<uint8_t>& buffer, MessageType type)
+    : out(buffer), start(buffer.size())
+{
+    out.push_back(static_cast<uint8_t>(type));
+    out.insert(out.end(), 4, 0);
+}
+
+MessageWriter::~MessageWriter()
+{
+    const uint32_t size = static_cast<uint32_t>(out.size() - start - MESSAGE_HEADER_BYTES);
+    for (int i = 0; i < 4; ++i) {
+        out[start + 1 + i] = static_cast<uint8_t>(size >> (8 * i));
+    }
+}
+
+void MessageWriter::u32(uint32_t v)
+{
+    for (int i = 0; i < 4; ++i) out.push_back(static_cast<uint8_t>(v >> (8 * i)));
+}
+
+void MessageWriter::u64(uint64_t v)
+{
+    for (int i = 0; i < 8; ++i) out.push_back(static_cast<uint8_t>(v >> (8 * i)));
+}
+
+void MessageWriter::f32(float v)
+{
+    uint32_t bits;
+    std::memcpy(&bits, &v, sizeof(bits));
+    u32(bits);
+}
+
+void MessageWriter::varint(uint64_t v)
+{
+    while (v >= 0x80) {
+        out.push_back(static_cast<uint8_t>(v | 0x80));
+        v >>= 7;
+    }
+    out.push_back(static_cast<uint8_t>(v));
+}
+
+uint8_t MessageReader::u8()
+{
+    const uint8_t* p = bytes(1);
+    return p ? p[0] : 0;
+}
+
+uint32_t MessageReader::u32()
+{
+    const uint8_t* p = bytes(4);
+    if (!p) return 0;
+    uint32_t v = 0;
+    for (int i = 0; i < 4; ++i) v |= static_cast<uint32_t>(p[i]) << (8 * i);
+    return v;
+}
+
+uint64_t MessageReader::u64()
+{
+    const uint8_t* p = bytes(8);
+    if (!p) return 0;
+    uint64_t v = 0;
+    for (int i = 0; i < 8; ++i) v |= static_cast<uint64_t>(p[i]) << (8 * i);
+    return v;
+}
+
+float MessageReader::f32()
+{
+    const uint32_t bits = u32();
+    float v;
+    std::memcpy(&v, &bits, sizeof(v));
+    return v;
+}
+
+uint64_t MessageReader::varint()
+{
+    uint64_t v = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        const uint8_t b = u8();
+        if (failed) return 0;
+        v |= static_cast<uint64_t>(b & 0x7F) << shift;
+        if ((b & 0x80) == 0) return v;
+    }
+    failed = true;
+    return 0;
+}
+
+const uint8_t* MessageReader::bytes(size_t n)
+{
+    if (failed || n > size - pos) {
+        failed = true;
+        return nullptr;
+    }
+    const uint8_t* p = data + pos;
+    pos += n;
+    return p;
+}
+
+void chunk_to_canonical(const Chunk& c, uint8_t* out)
+{
+    for (int z = 0; z < CHUNK_Z; ++z) {
+        for (int y = 0; y < CHUNK_Y; ++y) {
+            c.read_row(y, z, 0, CHUNK_X, out + CHUNK_X * (y + CHUNK_Y * z));
+        }
+    }
+}
+
+void chunk_from_canonical(Chunk& c, const uint8_t* in)
+{
+    for (int z = 0; z < CHUNK_Z; ++z) {
+        for (int y = 0; y < CHUNK_Y; ++y) {
+            c.write_row(y, z, 0, CHUNK_X, in + CHUNK_X * (y + CHUNK_Y * z), false);
+        }
+    }
+}
+
+void write_section_message(std::vector<uint8_t>& out, const World& world, int cx, int cy, int cz)
+{
+    MessageWriter w(out, MessageType::Section);
+    w.u8(static_cast<uint8_t>(cx));
+    w.u8(static_cast<uint8_t>(cy));
+    w.u8(static_cast<uint8_t>(cz));
+
+    const ChunkVersion* c = world.section_at(cx, cy, cz).chunk();
+    if (!c) {
+        w.u8(static_cast<uint8_t>(SectionEncoding::Uniform));
+        w.u8(static_cast<uint8_t>(world.section_at(cx, cy, cz).fill()));
+        return;
+    }
+
+    uint8_t blocks[CHUNK_VOLUME];
+    chunk_to_canonical(*c, blocks);
+
+    std::vector<uint8_t> palette;
+    std::vector<uint8_t> codes;
+    if (pack_block_codes(blocks, palette, codes) && 1 + palette.size() + codes.size() < CHUNK_VOLUME) {
+        w.u8(static_cast<uint8_t>(SectionEncoding::Packed));
+        w.u8(static_cast<uint8_t>(palette.size()));
+        w.bytes(palette.data(), palette.size());
+        w.bytes(codes.data(), codes.size());
+    }
+    else {
+        w.u8(static_cast<uint8_t>(SectionEncoding::Raw));
+        w.bytes(blocks, CHUNK_VOLUME);
+    }
+}
+
+bool read_section_blocks(MessageReader& r, uint8_t* out)
+{
+    switch (static_cast<SectionEncoding>(r.u8())) {
+    case SectionEncoding::Uniform:
+        std::memset(out, r.u8(), CHUNK_VOLUME);
+        return !r.failed;
+    case SectionEncoding::Packed: {
+        const size_t palette_size = r.u8();
+        const uint8_t* palette = r.bytes(palette_size);
+        if (r.failed) return false;
+        const size_t count = r.remaining();
+        return unpack_block_codes(palette, palette_size, r.bytes(count), count, out);
+    }
+    case SectionEncoding::Raw: {
+        const uint8_t* p = r.bytes(CHUNK_VOLUME);
+        if (!p) return false;
+        std::memcpy(out, p, CHUNK_VOLUME);
+        return true;
+    }
+    }
+    return false;
+}
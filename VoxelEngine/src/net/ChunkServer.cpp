@@ -0,0 +1,432 @@
+#include "net/ChunkServer.h"
+#include "net/ChunkProtocol.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+
+namespace {
+
+constexpr size_t RECV_CHUNK = 4096;
+constexpr size_t MAX_CLIENT_INPUT = 64 * 1024;
+
+// Above this many changes a section is sent whole instead of as a delta
+constexpr size_t MAX_DELTA_BLOCKS = CHUNK_VOLUME / 8;
+
+// Storage-order blocks of a section version, or its fill
+const uint8_t* section_blocks(const ChunkVersion* c, BlockType fill, uint8_t* scratch)
+{
+    if (c) return c->blocks.data();
+    std::memset(scratch, static_cast<uint8_t>(fill), CHUNK_VOLUME);
+    return scratch;
+}
+
+int canonical_index(int storage)
+{
+    int x = 0, y = 0, z = 0;
+    ChunkLayout::coords(storage, x, y, z);
+    return x + CHUNK_X * (y + CHUNK_Y * z);
+}
+
+// Tick payload before its records: u64 tick and the section count varint
+constexpr size_t TICK_HEADER_BYTES = 8 + 5;
+
+} // namespace
+
+struct ChunkServer::Client
+{
+    SocketHandle socket = INVALID_SOCKET_HANDLE;
+    std::vector<uint8_t> in;
+    std::vector<uint8_t> out;
+    size_t out_pos = 0;
+
+    bool has_view = false;
+    bool view_changed = false;
+    float x = 0.0f, y = 0.0f, z = 0.0f;
+    int radius = 0;
+
+    std::vector<uint8_t> held;          // per section: the client has it
+    std::vector<uint32_t> wanted;       // in view and not sent yet, nearest last
+    bool closed = false;
+
+    size_t backlog() const { return out.size() - out_pos; }
+};
+
+ChunkServer::ChunkServer(World& world, const ChunkServerSettings& settings)
+    : m_world(world), m_settings(settings), m_listener(INVALID_SOCKET_HANDLE)
+{
+    m_sections.resize(static_cast<size_t>(WORLD_CHUNKS_X * WORLD_CHUNKS_Z * world.chunks_y()));
+    for (size_t i = 0; i < m_sections.size(); ++i) {
+        const SectionCoord s = section_coord(i);
+        rebase(m_sections[i], world.section_at(s.cx, s.cy, s.cz));
+    }
+}
+
+ChunkServer::~ChunkServer()
+{
+    for (auto& c : m_clients) socket_close(c->socket);
+    socket_close(m_listener);
+
+    for (Baseline& b : m_sections) {
+        chunk_version_release(b.chunk);
+        packed_chunk_release(b.packed);
+    }
+}
+
+size_t ChunkServer::section_index(int cx, int cy, int cz) const
+{
+    return static_cast<size_t>(World::col_idx(cx, cz)) * static_cast<size_t>(m_world.chunks_y()) + static_cast<size_t>(cy);
+}
+
+SectionCoord ChunkServer::section_coord(size_t i) const
+{
+    const int chunks_y = m_world.chunks_y();
+    const int col = static_cast<int>(i) / chunks_y;
+    return SectionCoord{ col % WORLD_CHUNKS_X, static_cast<int>(i) % chunks_y, col / WORLD_CHUNKS_X };
+}
+
+bool ChunkServer::listen(const std::string& path)
+{
+    m_listener = socket_listen_local(path);
+    if (m_listener == INVALID_SOCKET_HANDLE) return false;
+
+    std::cout << "Chunk server: listening on " << path << "\n";
+    return true;
+}
+
+void ChunkServer::accept_clients()
+{
+    if (m_listener == INVALID_SOCKET_HANDLE) return;
+
+    for (;;) {
+        const SocketHandle s = socket_accept(m_listener);
+        if (s == INVALID_SOCKET_HANDLE) return;
+
+        if (static_cast<int>(m_clients.size()) >= m_settings.max_clients) {
+            socket_close(s);
+            continue;
+        }
+
+        auto c = std::make_unique<Client>();
+        c->socket = s;
+        c->held.assign(m_sections.size(), 0);
+        {
+            MessageWriter w(c->out, MessageType::Hello);
+            w.u32(CHUNK_PROTOCOL_VERSION);
+            w.u8(static_cast<uint8_t>(WORLD_CHUNKS_X));
+            w.u8(static_cast<uint8_t>(m_world.chunks_y()));
+            w.u8(static_cast<uint8_t>(WORLD_CHUNKS_Z));
+        }
+        m_clients.push_back(std::move(c));
+        ++m_stats.clients_accepted;
+    }
+}
+
+bool ChunkServer::handle_message(Client& c, uint8_t type, const uint8_t* payload, size_t size)
+{
+    if (static_cast<MessageType>(type) != MessageType::View) return false;
+
+    MessageReader r(payload, size);
+    const float x = r.f32();
+    const float y = r.f32();
+    const float z = r.f32();
+    const int radius = r.u8();
+    if (r.failed || !std::isfinite(x) || !std::isfinite(y) || !std::isfinite(z)) return false;
+
+    c.has_view = true;
+    c.view_changed = true;
+    c.x = x;
+    c.y = y;
+    c.z = z;
+    c.radius = radius;
+    return true;
+}
+
+bool ChunkServer::read_client(Client& c)
+{
+    uint8_t buf[RECV_CHUNK];
+    for (;;) {
+        const long n = socket_recv(c.socket, buf, sizeof(buf));
+        if (n < 0) return false;
+        if (n == 0) break;
+        c.in.insert(c.in.end(), buf, buf + n);
+        if (c.in.size() > MAX_CLIENT_INPUT) return false;
+    }
+
+    size_t pos = 0;
+    while (c.in.size() - pos >= MESSAGE_HEADER_BYTES) {
+        MessageReader header(c.in.data() + pos, MESSAGE_HEADER_BYTES);
+        const uint8_t type = header.u8();
+        const uint32_t size = header.u32();
+        if (size > MAX_MESSAGE_BYTES) return false;
+        if (c.in.size() - pos - MESSAGE_HEADER_BYTES < size) break;
+
+        if (!handle_message(c, type, c.in.data() + pos + MESSAGE_HEADER_BYTES, size)) return false;
+        pos += MESSAGE_HEADER_BYTES + size;
+    }
+    c.in.erase(c.in.begin(), c.in.begin() + static_cast<std::ptrdiff_t>(pos));
+    return true;
+}
+
+bool ChunkServer::flush_client(Client& c)
+{
+    while (c.out_pos < c.out.size()) {
+        const long n = socket_send(c.socket, c.out.data() + c.out_pos, c.out.size() - c.out_pos);
+        if (n < 0) return false;
+        if (n == 0) break;
+        c.out_pos += static_cast<size_t>(n);
+        m_stats.bytes_sent += static_cast<uint64_t>(n);
+    }
+
+    if (c.out_pos == c.out.size()) {
+        c.out.clear();
+        c.out_pos = 0;
+    }
+    else if (c.out_pos > c.out.size() / 2) {
+        c.out.erase(c.out.begin(), c.out.begin() + static_cast<std::ptrdiff_t>(c.out_pos));
+        c.out_pos = 0;
+    }
+    return true;
+}
+
+void ChunkServer::drop_client(Client& c)
+{
+    for (size_t i = 0; i < c.held.size(); ++i) {
+        if (c.held[i]) --m_sections[i].viewers;
+    }
+    socket_close(c.socket);
+    c.closed = true;
+}
+
+void ChunkServer::poll()
+{
+    accept_clients();
+
+    for (auto& c : m_clients) {
+        if (!read_client(*c) || !flush_client(*c)) drop_client(*c);
+    }
+
+    m_clients.erase(std::remove_if(m_clients.begin(), m_clients.end(), [](const std::unique_ptr<Client>& c) { return c->closed; }),
+        m_clients.end());
+    m_stats.clients = static_cast<uint32_t>(m_clients.size());
+}
+
+// Takes references to the section's current storage and drops the cached message.
+void ChunkServer::rebase(Baseline& b, const ChunkSection& sec)
+{
+    const ChunkVersion* chunk = sec.hot();
+    const PackedChunk* packed = sec.packed();
+    chunk_version_acquire(chunk);
+    packed_chunk_acquire(packed);
+    chunk_version_release(b.chunk);
+    packed_chunk_release(b.packed);
+
+    b.chunk = chunk;
+    b.packed = packed;
+    b.fill = sec.fill();
+    b.message.clear();
+}
+
+// Appends section i's delta record (coordinates, count, position gaps and
+// blocks) for the changes since its baseline and returns their count; 0 if
+// the blocks are unchanged (e.g. the section only moved between tiers).
+size_t ChunkServer::diff_section(size_t i, const ChunkSection& sec, std::vector<uint8_t>& record)
+{
+    const Baseline& b = m_sections[i];
+    uint8_t old_scratch[CHUNK_VOLUME];
+    uint8_t new_scratch[CHUNK_VOLUME];
+    const ChunkVersion* old_chunk = b.chunk ? b.chunk : (b.packed ? packed_chunk_view(b.packed) : nullptr);
+    const uint8_t* before = section_blocks(old_chunk, b.fill, old_scratch);
+    const uint8_t* after = section_blocks(sec.chunk(), sec.fill(), new_scratch);
+
+    std::vector<uint32_t> changes;      // canonical position << 8 | block
+    for (int s = 0; s < CHUNK_VOLUME; s += 8) {
+        uint64_t a, c;
+        std::memcpy(&a, before + s, 8);
+        std::memcpy(&c, after + s, 8);
+        if (a == c) continue;
+        for (int k = s; k < s + 8; ++k) {
+            if (before[k] != after[k]) changes.push_back(static_cast<uint32_t>(canonical_index(k)) << 8 | after[k]);
+        }
+    }
+    if (changes.empty()) return 0;
+    std::sort(changes.begin(), changes.end());
+
+    const SectionCoord at = section_coord(i);
+    record.push_back(static_cast<uint8_t>(at.cx));
+    record.push_back(static_cast<uint8_t>(at.cy));
+    record.push_back(static_cast<uint8_t>(at.cz));
+
+    // Same varint coding as MessageWriter, into a bare buffer
+    const auto varint = [&record](uint32_t v) {
+        while (v >= 0x80) {
+            record.push_back(static_cast<uint8_t>(v | 0x80));
+            v >>= 7;
+        }
+        record.push_back(static_cast<uint8_t>(v));
+    };
+
+    varint(static_cast<uint32_t>(changes.size()));
+    uint32_t prev = 0;
+    for (const uint32_t ch : changes) {
+        varint((ch >> 8) - prev);
+        record.push_back(static_cast<uint8_t>(ch));
+        prev = ch >> 8;
+    }
+    m_stats.delta_blocks += changes.size();
+    return changes.size();
+}
+
+void ChunkServer::update_interest(Client& c)
+{
+    c.view_changed = false;
+    c.wanted.clear();
+
+    for (size_t i = 0; i < m_sections.size(); ++i) {
+        const SectionCoord s = section_coord(i);
+        if (c.held[i]) {
+            // One section of slack, so a camera on a border does not thrash
+            if (section_in_view(s, c.x, c.y, c.z, c.radius + 1)) continue;
+
+            MessageWriter w(c.out, MessageType::Unload);
+            w.u8(static_cast<uint8_t>(s.cx));
+            w.u8(static_cast<uint8_t>(s.cy));
+            w.u8(static_cast<uint8_t>(s.cz));
+            c.held[i] = 0;
+            --m_sections[i].viewers;
+        }
+        else if (section_in_view(s, c.x, c.y, c.z, c.radius)) {
+            c.wanted.push_back(static_cast<uint32_t>(i));
+        }
+    }
+
+    const auto dist2 = [&](uint32_t i) {
+        const SectionCoord s = section_coord(i);
+        const float dx = (static_cast<float>(s.cx) + 0.5f) * CHUNK_X - c.x;
+        const float dy = (static_cast<float>(s.cy) + 0.5f) * CHUNK_Y - c.y;
+        const float dz = (static_cast<float>(s.cz) + 0.5f) * CHUNK_Z - c.z;
+        return dx * dx + dy * dy + dz * dz;
+    };
+    std::sort(c.wanted.begin(), c.wanted.end(), [&](uint32_t a, uint32_t b) { return dist2(a) > dist2(b); });
+}
+
+void ChunkServer::stream_sections(Client& c)
+{
+    int sent = 0;
+    while (!c.wanted.empty() && sent < m_settings.sections_per_update && c.backlog() < m_settings.max_backlog_bytes) {
+        const uint32_t i = c.wanted.back();
+        c.wanted.pop_back();
+
+        Baseline& b = m_sections[i];
+        c.held[i] = 1;
+        ++b.viewers;
+
+        // Clients start out all air and reset unloaded sections to air
+        if (!b.chunk && !b.packed && b.fill == BlockType::Air) continue;
+
+        if (b.message.empty()) {
+            const SectionCoord s = section_coord(i);
+            write_section_message(b.message, m_world, s.cx, s.cy, s.cz);
+            ++m_stats.sections_encoded;
+        }
+        c.out.insert(c.out.end(), b.message.begin(), b.message.end());
+        ++m_stats.sections_sent;
+        m_stats.section_bytes += b.message.size();
+        ++sent;
+    }
+}
+
+void ChunkServer::update(uint64_t tick)
+{
+    const auto t0 = std::chrono::steady_clock::now();
+
+    // Sections whose storage changed since the last update. Only those with
+    // viewers are diffed; a section with too many changes is resent whole.
+    m_changed.clear();
+    m_records.clear();
+    std::vector<uint32_t> resent;
+    for (size_t i = 0; i < m_sections.size(); ++i) {
+        Baseline& b = m_sections[i];
+        const SectionCoord s = section_coord(i);
+        const ChunkSection& sec = m_world.section_at(s.cx, s.cy, s.cz);
+        if (sec.hot() == b.chunk && sec.packed() == b.packed && sec.fill() == b.fill) continue;
+
+        if (b.viewers > 0) {
+            std::vector<uint8_t> record;
+            const size_t changes = diff_section(i, sec, record);
+            if (changes > 0) {
+                ++m_stats.sections_changed;
+                if (changes > MAX_DELTA_BLOCKS) {
+                    resent.push_back(static_cast<uint32_t>(i));
+                }
+                else {
+                    m_changed.push_back(static_cast<uint32_t>(i));
+                    m_records.push_back(std::move(record));
+                }
+            }
+        }
+        rebase(b, sec);
+    }
+
+    for (const uint32_t i : resent) {
+        const SectionCoord s = section_coord(i);
+        write_section_message(m_sections[i].message, m_world, s.cx, s.cy, s.cz);
+        ++m_stats.sections_encoded;
+    }
+
+    for (auto& cp : m_clients) {
+        Client& c = *cp;
+
+        // Changes first: they refer to sections the client held before this update
+        for (const uint32_t i : resent) {
+            if (!c.held[i]) continue;
+            c.out.insert(c.out.end(), m_sections[i].message.begin(), m_sections[i].message.end());
+            ++m_stats.sections_sent;
+            m_stats.section_bytes += m_sections[i].message.size();
+        }
+
+        // The tick's records, split over as many Tick messages as it takes
+        // to keep each under MAX_MESSAGE_BYTES
+        const size_t before = c.out.size();
+        size_t k = 0;
+        while (k < m_changed.size()) {
+            uint32_t sections = 0;
+            size_t bytes = TICK_HEADER_BYTES;
+            size_t end = k;
+            for (; end < m_changed.size(); ++end) {
+                if (!c.held[m_changed[end]]) continue;
+                if (sections > 0 && bytes + m_records[end].size() > MAX_MESSAGE_BYTES) break;
+                bytes += m_records[end].size();
+                ++sections;
+            }
+            if (sections > 0) {
+                MessageWriter w(c.out, MessageType::Tick);
+                w.u64(tick);
+                w.varint(sections);
+                for (; k < end; ++k) {
+                    if (c.held[m_changed[k]]) w.bytes(m_records[k].data(), m_records[k].size());
+                }
+            }
+            k = end;
+        }
+        m_stats.delta_bytes += c.out.size() - before;
+
+        if (c.view_changed) update_interest(c);
+        if (c.has_view) stream_sections(c);
+        if (!flush_client(c)) {
+            drop_client(c);
+        }
+        else if (c.backlog() > m_settings.max_unsent_bytes) {
+            std::cout << "Chunk server: dropped a client with " << c.backlog() << " bytes unsent\n";
+            ++m_stats.clients_stalled;
+            drop_client(c);
+        }
+    }
+
+    m_clients.erase(std::remove_if(m_clients.begin(), m_clients.end(), [](const std::unique_ptr<Client>& c) { return c->closed; }),
+        m_clients.end());
+    m_stats.clients = static_cast<uint32_t>(m_clients.size());
+    m_stats.update_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+}
@@ -0,0 +1,160 @@
+#include "net/HeadlessServer.h"
+#include "core/FixedTimestep.h"
+#include "core/JobPool.h"
+#include "net/ChunkClient.h"
+#include "net/ChunkServer.h"
+#include "world/TickScheduler.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <csignal>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+volatile std::sig_atomic_t g_interrupted = 0;
+
+void on_interrupt(int)
+{
+    g_interrupted = 1;
+}
+
+double seconds_since(clock_type::time_point t0)
+{
+    return std::chrono::duration<double>(clock_type::now() - t0).count();
+}
+
+} // namespace
+
+bool run_headless_server(World& world, const HeadlessServerSettings& settings)
+{
+    if (!socket_startup()) return false;
+
+    ChunkServer server(world);
+    if (!server.listen(settings.socket_path)) return false;
+
+    JobPool pool;
+    TickScheduler scheduler(world, pool);
+    FixedTimestep clock(1.0 / std::max(settings.tick_hz, 1.0));
+
+    g_interrupted = 0;
+    std::signal(SIGINT, on_interrupt);
+
+    const auto start = clock_type::now();
+    auto last = start;
+    double next_log = settings.log_interval;
+    while (!g_interrupted && (settings.seconds <= 0.0 || seconds_since(start) < settings.seconds)) {
+        const auto now = clock_type::now();
+        const double dt = std::chrono::duration<double>(now - last).count();
+        last = now;
+
+        server.poll();
+
+        if (settings.tick_hz > 0.0) {
+            const int steps = clock.advance(dt);
+            for (int i = 0; i < steps; ++i) {
+                scheduler.wake_sections(world.take_dirty_sections());
+                scheduler.tick();
+                world.take_dirty_sections();
+                server.update(scheduler.current_tick());
+            }
+        }
+        else {
+            // Frozen simulation: still stream sections to new viewers
+            server.update(scheduler.current_tick());
+        }
+
+        world.advance_frame();
+        chunk_versions_collect();
+
+        if (settings.log_interval > 0.0 && seconds_since(start) >= next_log) {
+            next_log += settings.log_interval;
+            const ChunkServerStats& s = server.stats();
+            std::cout << "Server: tick " << scheduler.current_tick() << ", " << s.clients << " clients, "
+                      << s.sections_sent << " sections, " << s.delta_blocks << " block changes, "
+                      << s.bytes_sent << " bytes sent, update " << s.update_ms << " ms, "
+                      << scheduler.active_blocks() << " active blocks\n";
+        }
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    std::signal(SIGINT, SIG_DFL);
+    std::cout << "Server: stopped at tick " << scheduler.current_tick() << ", "
+              << server.stats().clients_accepted << " clients served\n";
+    return true;
+}
+
+bool run_bot_clients(const std::string& socket_path, int count, int radius, float height,
+    double seconds, double log_interval)
+{
+    if (!socket_startup()) return false;
+
+    std::vector<std::unique_ptr<ChunkClient>> bots;
+    for (int i = 0; i < count; ++i) {
+        auto bot = std::make_unique<ChunkClient>();
+        if (!bot->connect(socket_path)) return false;
+        bots.push_back(std::move(bot));
+    }
+    std::cout << "Bots: " << count << " connected to " << socket_path << "\n";
+
+    g_interrupted = 0;
+    std::signal(SIGINT, on_interrupt);
+
+    const auto start = clock_type::now();
+    double next_move = 0.0;
+    double next_log = log_interval;
+    bool ok = true;
+    while (ok && !g_interrupted && (seconds <= 0.0 || seconds_since(start) < seconds)) {
+        const double t = seconds_since(start);
+
+        // Each bot circles the world center, spread around the circle
+        if (t >= next_move) {
+            next_move += 0.5;
+            for (int i = 0; i < count; ++i) {
+                const float a = 6.2831853f * static_cast<float>(i) / static_cast<float>(count) + 0.1f * static_cast<float>(t);
+                const float r = 0.3f * static_cast<float>(WORLD_SIZE_X);
+                bots[static_cast<size_t>(i)]->set_view(0.5f * WORLD_SIZE_X + r * std::cos(a), height,
+                    0.5f * WORLD_SIZE_Z + r * std::sin(a), radius);
+            }
+        }
+
+        for (auto& bot : bots) {
+            if (!bot->poll()) {
+                std::cerr << "Bots: disconnected from " << socket_path << "\n";
+                ok = false;
+                break;
+            }
+            // No mesher here: drop the remesh queue
+            if (World* w = bot->world()) w->take_dirty_sections();
+        }
+        chunk_versions_collect();
+
+        if (log_interval > 0.0 && t >= next_log) {
+            next_log += log_interval;
+            ChunkClientStats total;
+            for (const auto& bot : bots) {
+                const ChunkClientStats& s = bot->stats();
+                total.bytes_received += s.bytes_received;
+                total.sections += s.sections;
+                total.unloads += s.unloads;
+                total.delta_blocks += s.delta_blocks;
+                total.last_tick = std::max(total.last_tick, s.last_tick);
+            }
+            std::cout << "Bots: " << total.sections << " sections, " << total.unloads << " unloads, "
+                      << total.delta_blocks << " block changes, " << total.bytes_received
+                      << " bytes received, server tick " << total.last_tick << "\n";
+        }
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+
+    std::signal(SIGINT, SIG_DFL);
+    return ok;
+}
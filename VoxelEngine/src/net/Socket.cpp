@@ -0,0 +1,176 @@
+#include "net/Socket.h"
+
+#include <cstring>
+#include <iostream>
+
+#ifdef _WIN32
+#include <winsock2.h>
+#include <afunix.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+#ifdef _WIN32
+const SocketHandle INVALID_SOCKET_HANDLE = INVALID_SOCKET;
+#else
+const SocketHandle INVALID_SOCKET_HANDLE = -1;
+#endif
+
+namespace {
+
+bool would_block()
+{
+#ifdef _WIN32
+    return WSAGetLastError() == WSAEWOULDBLOCK;
+#else
+    return errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR;
+#endif
+}
+
+bool set_nonblocking(SocketHandle s)
+{
+#ifdef _WIN32
+    u_long on = 1;
+    return ioctlsocket(s, FIONBIO, &on) == 0;
+#else
+    const int flags = fcntl(s, F_GETFL, 0);
+    return flags >= 0 && fcntl(s, F_SETFL, flags | O_NONBLOCK) == 0;
+#endif
+}
+
+// A send to a closed peer must fail with an error, not raise SIGPIPE. Where
+// send() has no MSG_NOSIGNAL flag (macOS, BSDs) the socket option does it.
+bool suppress_sigpipe(SocketHandle s)
+{
+#if !defined(_WIN32) && !defined(MSG_NOSIGNAL) && defined(SO_NOSIGPIPE)
+    const int on = 1;
+    return setsockopt(s, SOL_SOCKET, SO_NOSIGPIPE, &on, sizeof(on)) == 0;
+#else
+    (void)s;
+    return true;
+#endif
+}
+
+bool make_address(const std::string& path, sockaddr_un& addr)
+{
+    std::memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    if (path.empty() || path.size() >= sizeof(addr.sun_path)) {
+        std::cerr << "Socket path too long: " << path << "\n";
+        return false;
+    }
+    std::memcpy(addr.sun_path, path.c_str(), path.size());
+    return true;
+}
+
+SocketHandle open_socket()
+{
+    const SocketHandle s = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (s == INVALID_SOCKET_HANDLE) std::cerr << "Failed to create socket\n";
+    return s;
+}
+
+} // namespace
+
+bool socket_startup()
+{
+#ifdef _WIN32
+    WSADATA data;
+    if (WSAStartup(MAKEWORD(2, 2), &data) != 0) {
+        std::cerr << "Failed to initialize Winsock\n";
+        return false;
+    }
+#endif
+    return true;
+}
+
+SocketHandle socket_listen_local(const std::string& path)
+{
+    sockaddr_un addr;
+    if (!make_address(path, addr)) return INVALID_SOCKET_HANDLE;
+
+    const SocketHandle s = open_socket();
+    if (s == INVALID_SOCKET_HANDLE) return s;
+
+#ifdef _WIN32
+    DeleteFileA(path.c_str());
+#else
+    unlink(path.c_str());
+#endif
+
+    if (bind(s, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr)) != 0 ||
+        listen(s, 64) != 0 || !set_nonblocking(s)) {
+        std::cerr << "Failed to listen on " << path << "\n";
+        socket_close(s);
+        return INVALID_SOCKET_HANDLE;
+    }
+    return s;
+}
+
+SocketHandle socket_connect_local(const std::string& path)
+{
+    sockaddr_un addr;
+    if (!make_address(path, addr)) return INVALID_SOCKET_HANDLE;
+
+    const SocketHandle s = open_socket();
+    if (s == INVALID_SOCKET_HANDLE) return s;
+
+    // Connect blocking (local sockets connect at once), then switch over
+    if (connect(s, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr)) != 0 ||
+        !set_nonblocking(s) || !suppress_sigpipe(s)) {
+        std::cerr << "Failed to connect to " << path << "\n";
+        socket_close(s);
+        return INVALID_SOCKET_HANDLE;
+    }
+    return s;
+}
+
+SocketHandle socket_accept(SocketHandle listener)
+{
+    const SocketHandle s = accept(listener, nullptr, nullptr);
+    if (s == INVALID_SOCKET_HANDLE) return s;
+    if (!set_nonblocking(s) || !suppress_sigpipe(s)) {
+        socket_close(s);
+        return INVALID_SOCKET_HANDLE;
+    }
+    return s;
+}
+
+long socket_send(SocketHandle s, const uint8_t* data, size_t size)
+{
+#ifdef _WIN32
+    const int n = send(s, reinterpret_cast<const char*>(data), static_cast<int>(size), 0);
+#elif defined(MSG_NOSIGNAL)
+    const ssize_t n = send(s, data, size, MSG_NOSIGNAL);
+#else
+    const ssize_t n = send(s, data, size, 0);
+#endif
+    if (n >= 0) return static_cast<long>(n);
+    return would_block() ? 0 : -1;
+}
+
+long socket_recv(SocketHandle s, uint8_t* data, size_t size)
+{
+#ifdef _WIN32
+    const int n = recv(s, reinterpret_cast<char*>(data), static_cast<int>(size), 0);
+#else
+    const ssize_t n = recv(s, data, size, 0);
+#endif
+    if (n > 0) return static_cast<long>(n);
+    if (n == 0) return -1;      // orderly shutdown
+    return would_block() ? 0 : -1;
+}
+
+void socket_close(SocketHandle s)
+{
+    if (s == INVALID_SOCKET_HANDLE) return;
+#ifdef _WIN32
+    closesocket(s);
+#else
+    close(s);
+#endif
+}
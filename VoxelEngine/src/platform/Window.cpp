@@ -15,7 +15,7 @@ Window::~Window()
     shutdown();
 }
 
-bool Window::init()
+bool Window::init(bool visible)
 {
     if (!glfwInit()) {
         std::cerr << "Failed to initialize GLFW\n";
@@ -30,6 +30,9 @@ bool Window::init()
     glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
 #endif
 
+    // Hidden windows still get a full default framebuffer (used by benchmarks)
+    glfwWindowHint(GLFW_VISIBLE, visible ? GLFW_TRUE : GLFW_FALSE);
+
     m_window = glfwCreateWindow(m_init_w, m_init_h, m_title.c_str(), nullptr, nullptr);
     if (!m_window) {
         std::cerr << "Failed to create GLFW window\n";
@@ -80,6 +83,11 @@ void Window::swap_buffers()
     glfwSwapBuffers(m_window);
 }
 
+void Window::set_vsync(bool enabled)
+{
+    glfwSwapInterval(enabled ? 1 : 0);
+}
+
 bool Window::should_close() const
 {
     return glfwWindowShouldClose(m_window) != 0;
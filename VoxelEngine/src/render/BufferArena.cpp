@@ -0,0 +1,65 @@
+#include "render/BufferArena.h"
+
+#include <algorithm>
+
+BufferArena::BufferArena(size_t capacity)
+{
+    grow(capacity);
+}
+
+size_t BufferArena::alloc(size_t size)
+{
+    if (size == 0) return 0;
+
+    for (size_t i = 0; i < m_free.size(); ++i) {
+        Range& r = m_free[i];
+        if (r.size < size) continue;
+
+        const size_t offset = r.offset;
+        r.offset += size;
+        r.size -= size;
+        if (r.size == 0) m_free.erase(m_free.begin() + static_cast<std::ptrdiff_t>(i));
+        m_used += size;
+        return offset;
+    }
+    return INVALID;
+}
+
+void BufferArena::free(size_t offset, size_t size)
+{
+    if (size == 0) return;
+    m_used -= size;
+
+    auto next = std::lower_bound(m_free.begin(), m_free.end(), offset, [](const Range& r, size_t o) { return r.offset < o; });
+    const bool join_prev = next != m_free.begin() && std::prev(next)->offset + std::prev(next)->size == offset;
+    const bool join_next = next != m_free.end() && offset + size == next->offset;
+
+    if (join_prev && join_next) {
+        std::prev(next)->size += size + next->size;
+        m_free.erase(next);
+    }
+    else if (join_prev) {
+        std::prev(next)->size += size;
+    }
+    else if (join_next) {
+        next->offset = offset;
+        next->size += size;
+    }
+    else {
+        m_free.insert(next, Range{ offset, size });
+    }
+}
+
+void BufferArena::grow(size_t new_capacity)
+{
+    if (new_capacity <= m_capacity) return;
+
+    const size_t added = new_capacity - m_capacity;
+    if (!m_free.empty() && m_free.back().offset + m_free.back().size == m_capacity) {
+        m_free.back().size += added;
+    }
+    else {
+        m_free.push_back(Range{ m_capacity, added });
+    }
+    m_capacity = new_capacity;
+}
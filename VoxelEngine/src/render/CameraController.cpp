@@ -3,36 +3,68 @@
 #include <GLFW/glfw3.h>
 
 CameraController::CameraController(Camera& cam)
-    : m_cam(cam)
+    : m_cam(cam), m_prev_pos(cam.pos), m_curr_pos(cam.pos)
 {
 }
 
-void CameraController::update(Window& window, float dt_seconds)
+MoveInput CameraController::sample_input(Window& window) const
 {
-    // Mouse look
-    const auto [dx, dy] = window.consume_mouse_delta();
-    if (dx != 0.0f || dy != 0.0f) {
-        m_cam.process_mouse(dx, dy);
+    MoveInput in;
+    in.yaw = m_cam.yaw;
+    in.pitch = m_cam.pitch;
+
+    if (window.key_down(GLFW_KEY_W))            in.keys |= MOVE_FORWARD;
+    if (window.key_down(GLFW_KEY_S))            in.keys |= MOVE_BACK;
+    if (window.key_down(GLFW_KEY_A))            in.keys |= MOVE_LEFT;
+    if (window.key_down(GLFW_KEY_D))            in.keys |= MOVE_RIGHT;
+    if (window.key_down(GLFW_KEY_SPACE))        in.keys |= MOVE_UP;
+    if (window.key_down(GLFW_KEY_LEFT_CONTROL)) in.keys |= MOVE_DOWN;
+    if (window.key_down(GLFW_KEY_LEFT_SHIFT))   in.keys |= MOVE_SPRINT;
+
+    if (window.key_down(GLFW_KEY_ESCAPE)) {
+        window.set_should_close(true);
     }
+    return in;
+}
+
+void CameraController::step(const MoveInput& in, float dt_seconds)
+{
+    // Move along the direction recorded with the input, not the live camera's,
+    // so replaying the same inputs reproduces the same positions.
+    m_cam.yaw = in.yaw;
+    m_cam.pitch = in.pitch;
+    m_cam.update_vectors();
 
-    // Keyboard move
     float speed = m_cam.move_speed;
-    if (window.key_down(GLFW_KEY_LEFT_SHIFT)) {
+    if (in.keys & MOVE_SPRINT) {
         speed *= 2.5f;
     }
 
     const float v = speed * dt_seconds;
 
-    if (window.key_down(GLFW_KEY_W)) m_cam.pos += m_cam.front * v;
-    if (window.key_down(GLFW_KEY_S)) m_cam.pos -= m_cam.front * v;
+    glm::vec3 p = m_curr_pos;
+    if (in.keys & MOVE_FORWARD) p += m_cam.front * v;
+    if (in.keys & MOVE_BACK)    p -= m_cam.front * v;
 
-    if (window.key_down(GLFW_KEY_A)) m_cam.pos -= m_cam.right * v;
-    if (window.key_down(GLFW_KEY_D)) m_cam.pos += m_cam.right * v;
+    if (in.keys & MOVE_LEFT)    p -= m_cam.right * v;
+    if (in.keys & MOVE_RIGHT)   p += m_cam.right * v;
 
-    if (window.key_down(GLFW_KEY_SPACE))        m_cam.pos += m_cam.world_up * v;
-    if (window.key_down(GLFW_KEY_LEFT_CONTROL)) m_cam.pos -= m_cam.world_up * v;
+    if (in.keys & MOVE_UP)      p += m_cam.world_up * v;
+    if (in.keys & MOVE_DOWN)    p -= m_cam.world_up * v;
 
-    if (window.key_down(GLFW_KEY_ESCAPE)) {
-        window.set_should_close(true);
+    m_prev_pos = m_curr_pos;
+    m_curr_pos = p;
+}
+
+void CameraController::apply_look(Window& window)
+{
+    const auto [dx, dy] = window.consume_mouse_delta();
+    if (dx != 0.0f || dy != 0.0f) {
+        m_cam.process_mouse(dx, dy);
     }
 }
+
+void CameraController::interpolate(float alpha)
+{
+    m_cam.pos = m_prev_pos + (m_curr_pos - m_prev_pos) * alpha;
+}
@@ -0,0 +1,117 @@
+#include "render/CameraPath.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+CameraPath CameraPath::orbit(const glm::vec3& center, float radius, float height, float duration_seconds)
+{
+    // One full turn, looking at the center, keyed every half second
+    CameraPath path;
+    const int steps = std::max(2, static_cast<int>(duration_seconds * 2.0f));
+    const float pitch = -glm::degrees(std::atan2(height, radius));
+
+    for (int i = 0; i <= steps; ++i) {
+        const float u = static_cast<float>(i) / static_cast<float>(steps);
+        const float angle = u * 360.0f;
+
+        CameraKey key;
+        key.t = u * duration_seconds;
+        key.pos = center + glm::vec3(std::cos(glm::radians(angle)) * radius, height, std::sin(glm::radians(angle)) * radius);
+        key.yaw = angle + 180.0f;
+        key.pitch = pitch;
+        path.add_key(key);
+    }
+    return path;
+}
+
+bool CameraPath::load(const std::string& path)
+{
+    std::ifstream in(path);
+    if (!in) {
+        std::cerr << "Failed to open camera path '" << path << "'\n";
+        return false;
+    }
+
+    m_keys.clear();
+
+    std::string line;
+    int line_no = 0;
+    while (std::getline(in, line)) {
+        ++line_no;
+        const size_t hash = line.find('#');
+        if (hash != std::string::npos) line.erase(hash);
+        if (line.find_first_not_of(" \t\r") == std::string::npos) continue;
+
+        std::istringstream ss(line);
+        CameraKey key;
+        if (!(ss >> key.t >> key.pos.x >> key.pos.y >> key.pos.z >> key.yaw >> key.pitch)) {
+            std::cerr << "Camera path '" << path << "' line " << line_no << ": expected 't x y z yaw pitch'\n";
+            return false;
+        }
+        if (!m_keys.empty() && key.t < m_keys.back().t) {
+            std::cerr << "Camera path '" << path << "' line " << line_no << ": keys must be in time order\n";
+            return false;
+        }
+        m_keys.push_back(key);
+    }
+
+    if (m_keys.empty()) {
+        std::cerr << "Camera path '" << path << "' has no keys\n";
+        return false;
+    }
+    return true;
+}
+
+bool CameraPath::save(const std::string& path) const
+{
+    std::ofstream out(path);
+    if (!out) {
+        std::cerr << "Failed to write camera path '" << path << "'\n";
+        return false;
+    }
+
+    out << "# t x y z yaw pitch\n";
+    for (const CameraKey& k : m_keys) {
+        out << k.t << ' ' << k.pos.x << ' ' << k.pos.y << ' ' << k.pos.z << ' ' << k.yaw << ' ' << k.pitch << '\n';
+    }
+    return static_cast<bool>(out);
+}
+
+void CameraPath::add_key(const CameraKey& key)
+{
+    m_keys.push_back(key);
+}
+
+void CameraPath::sample(float t, Camera& cam) const
+{
+    if (m_keys.empty()) return;
+
+    const auto next = std::upper_bound(m_keys.begin(), m_keys.end(), t,
+        [](float v, const CameraKey& k) { return v < k.t; });
+
+    CameraKey pose;
+    if (next == m_keys.begin()) {
+        pose = m_keys.front();
+    }
+    else if (next == m_keys.end()) {
+        pose = m_keys.back();
+    }
+    else {
+        const CameraKey& a = *(next - 1);
+        const CameraKey& b = *next;
+        const float span = b.t - a.t;
+        const float u = (span > 0.0f) ? (t - a.t) / span : 1.0f;
+
+        pose.pos = glm::mix(a.pos, b.pos, u);
+        pose.yaw = glm::mix(a.yaw, b.yaw, u);
+        pose.pitch = glm::mix(a.pitch, b.pitch, u);
+    }
+
+    cam.pos = pose.pos;
+    cam.yaw = pose.yaw;
+    cam.pitch = std::clamp(pose.pitch, -89.0f, 89.0f);
+    cam.update_vectors();
+}
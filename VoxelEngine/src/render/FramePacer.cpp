@@ -0,0 +1,46 @@
+#include "render/FramePacer.h"
+
+#include <algorithm>
+#include <chrono>
+
+FramePacer::FramePacer(int max_frames_ahead)
+    : m_frames_ahead(std::clamp(max_frames_ahead, 0, MAX_FRAMES_AHEAD))
+{
+}
+
+FramePacer::~FramePacer()
+{
+    for (GLsync& f : m_fences) {
+        if (f) glDeleteSync(f);
+        f = nullptr;
+    }
+}
+
+void FramePacer::wait()
+{
+    m_last_wait_ms = 0.0;
+    if (m_frames_ahead == 0) return;
+
+    GLsync& f = m_fences[m_next];
+    if (!f) return;
+
+    const auto t0 = std::chrono::steady_clock::now();
+    // One second timeout; a lost context must not hang the loop
+    glClientWaitSync(f, GL_SYNC_FLUSH_COMMANDS_BIT, 1'000'000'000ull);
+    const auto t1 = std::chrono::steady_clock::now();
+
+    glDeleteSync(f);
+    f = nullptr;
+    m_last_wait_ms = std::chrono::duration<double, std::milli>(t1 - t0).count();
+}
+
+void FramePacer::end_frame()
+{
+    if (m_frames_ahead == 0) return;
+
+    GLsync& f = m_fences[m_next];
+    if (f) glDeleteSync(f);
+    f = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+    m_next = (m_next + 1) % static_cast<size_t>(m_frames_ahead);
+}
@@ -1,4 +1,5 @@
 #include "render/GLShader.h"
+#include "render/ShaderCache.h"
 
 #include <iostream>
 
@@ -30,13 +31,25 @@ GLuint ShaderProgram::compile(GLenum type, const char* src)
     return sh;
 }
 
-bool ShaderProgram::build_from_sources(const char* vs_source, const char* fs_source)
+bool ShaderProgram::build_from_sources(const char* vs_source, const char* fs_source, const ShaderCache* cache)
 {
     if (m_program) {
         glDeleteProgram(m_program);
         m_program = 0;
     }
 
+    const bool use_cache = cache && cache->enabled();
+    const uint64_t key = use_cache ? cache->key_for(vs_source, fs_source) : 0;
+
+    if (use_cache) {
+        GLuint cached = glCreateProgram();
+        if (cache->load(cached, key)) {
+            m_program = cached;
+            return true;
+        }
+        glDeleteProgram(cached);
+    }
+
     GLuint vs = compile(GL_VERTEX_SHADER, vs_source);
     if (!vs) return false;
 
@@ -47,6 +60,9 @@ bool ShaderProgram::build_from_sources(const char* vs_source, const char* fs_sou
     }
 
     GLuint prog = glCreateProgram();
+    if (use_cache) {
+        glProgramParameteri(prog, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    }
     glAttachShader(prog, vs);
     glAttachShader(prog, fs);
     glLinkProgram(prog);
@@ -66,6 +82,10 @@ bool ShaderProgram::build_from_sources(const char* vs_source, const char* fs_sou
         return false;
     }
 
+    if (use_cache) {
+        cache->store(prog, key);
+    }
+
     m_program = prog;
     return true;
 }
@@ -0,0 +1,70 @@
+#include "render/InputLog.h"
+
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <sstream>
+
+bool InputLog::load(const std::string& path)
+{
+    std::ifstream in(path);
+    if (!in) {
+        std::cerr << "Failed to open input log '" << path << "'\n";
+        return false;
+    }
+
+    m_step = 0.0;
+    m_ticks.clear();
+
+    std::string line;
+    int line_no = 0;
+    while (std::getline(in, line)) {
+        ++line_no;
+
+        // "# step <seconds>" header
+        if (line.rfind("# step ", 0) == 0) {
+            std::istringstream(line.substr(7)) >> m_step;
+            continue;
+        }
+
+        const size_t hash = line.find('#');
+        if (hash != std::string::npos) line.erase(hash);
+        if (line.find_first_not_of(" \t\r") == std::string::npos) continue;
+
+        std::istringstream ss(line);
+        unsigned keys = 0;
+        MoveInput tick;
+        if (!(ss >> keys >> tick.yaw >> tick.pitch) || keys > 0xFF) {
+            std::cerr << "Input log '" << path << "' line " << line_no << ": expected 'keys yaw pitch'\n";
+            return false;
+        }
+        tick.keys = static_cast<uint8_t>(keys);
+        m_ticks.push_back(tick);
+    }
+
+    if (m_step <= 0.0) {
+        std::cerr << "Input log '" << path << "' has no '# step' header\n";
+        return false;
+    }
+    return true;
+}
+
+bool InputLog::save(const std::string& path) const
+{
+    std::ofstream out(path);
+    if (!out) {
+        std::cerr << "Failed to write input log '" << path << "'\n";
+        return false;
+    }
+
+    // Full float precision: replay must see bit-identical look angles
+    out << std::setprecision(std::numeric_limits<double>::max_digits10);
+    out << "# step " << m_step << "\n";
+    out << "# keys yaw pitch\n";
+    out << std::setprecision(std::numeric_limits<float>::max_digits10);
+    for (const MoveInput& t : m_ticks) {
+        out << static_cast<unsigned>(t.keys) << ' ' << t.yaw << ' ' << t.pitch << '\n';
+    }
+    return static_cast<bool>(out);
+}
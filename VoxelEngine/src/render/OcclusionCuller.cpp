@@ -0,0 +1,403 @@
+#include "render/OcclusionCuller.h"
+#include "world/BlockRegistry.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+
+namespace {
+
+// Occluders and sections closer than this (clip w) are never trusted.
+constexpr float NEAR_W = 0.1f;
+
+// Footprint of one occluder slab, in blocks.
+constexpr int SLAB = 4;
+
+// Box corner i has x from bit 0, y from bit 1, z from bit 2.
+glm::vec3 box_corner(const glm::vec3& lo, const glm::vec3& hi, int i)
+{
+    return glm::vec3((i & 1) ? hi.x : lo.x, (i & 2) ? hi.y : lo.y, (i & 4) ? hi.z : lo.z);
+}
+
+// Corner cycles of the six faces, in the same order as Projected::faces bits.
+constexpr int FACE_CORNERS[6][4] = {
+    { 0, 2, 6, 4 },     // -x
+    { 1, 3, 7, 5 },     // +x
+    { 0, 1, 5, 4 },     // -y
+    { 2, 3, 7, 6 },     // +y
+    { 0, 1, 3, 2 },     // -z
+    { 4, 5, 7, 6 },     // +z
+};
+
+// Height of the opaque run starting at y = 0 in block column (gx, gz).
+int solid_run(const World& world, int gx, int gz)
+{
+    const int cx = gx / CHUNK_X;
+    const int cz = gz / CHUNK_Z;
+    const int lx = gx % CHUNK_X;
+    const int lz = gz % CHUNK_Z;
+
+    int h = 0;
+    for (int cy = 0; cy < world.chunks_y(); ++cy) {
+        const ChunkSection& sec = world.section_at(cx, cy, cz);
+        if (sec.is_uniform()) {
+            if (!block_opaque(sec.fill())) return h;
+            h += CHUNK_Y;
+            continue;
+        }
+
+        const ChunkVersion* c = sec.chunk();
+        for (int ly = 0; ly < CHUNK_Y; ++ly) {
+            if (!block_opaque(c->get_local(lx, ly, lz))) return h;
+            ++h;
+        }
+    }
+    return h;
+}
+
+double ms_since(std::chrono::steady_clock::time_point t0)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+}
+
+} // namespace
+
+void build_occluders(const World& world, const glm::vec3& world_origin, std::vector<OccluderBox>& out)
+{
+    constexpr int FOOT_X = WORLD_SIZE_X / SLAB;
+    constexpr int FOOT_Z = WORLD_SIZE_Z / SLAB;
+
+    out.clear();
+
+    std::array<int, FOOT_X> row{};
+    for (int fz = 0; fz < FOOT_Z; ++fz) {
+        for (int fx = 0; fx < FOOT_X; ++fx) {
+            int h = world.size_y();
+            for (int z = fz * SLAB; z < (fz + 1) * SLAB; ++z) {
+                for (int x = fx * SLAB; x < (fx + 1) * SLAB; ++x) {
+                    h = std::min(h, solid_run(world, x, z));
+                }
+            }
+            row[fx] = h;
+        }
+
+        for (int fx = 0; fx < FOOT_X;) {
+            int end = fx + 1;
+            while (end < FOOT_X && row[end] == row[fx]) ++end;
+
+            // Very thin slabs hide almost nothing
+            if (row[fx] >= 2) {
+                OccluderBox b;
+                b.min = world_origin + glm::vec3(static_cast<float>(fx * SLAB), 0.0f, static_cast<float>(fz * SLAB));
+                b.max = world_origin + glm::vec3(static_cast<float>(end * SLAB), static_cast<float>(row[fx]), static_cast<float>((fz + 1) * SLAB));
+                out.push_back(b);
+            }
+            fx = end;
+        }
+    }
+}
+
+OcclusionCuller::OcclusionCuller(JobPool& pool)
+    : m_pool(pool)
+{
+    for (int l = 0; l < LEVELS; ++l) {
+        const size_t n = static_cast<size_t>((WIDTH >> l) * (HEIGHT >> l));
+        m_min[l].resize(n);
+        if (l > 0) m_max[l].resize(n);
+    }
+}
+
+uint32_t cull_by_distance(const glm::vec3& eye, float max_distance,
+    const std::vector<SectionDraw>& sections, std::vector<uint8_t>& visible)
+{
+    const float max_sq = max_distance * max_distance;
+    uint32_t culled = 0;
+    for (size_t i = 0; i < sections.size(); ++i) {
+        if (!visible[i]) continue;
+        const glm::vec3 nearest = glm::clamp(eye, sections[i].min, sections[i].max);
+        const glm::vec3 d = nearest - eye;
+        if (glm::dot(d, d) > max_sq) {
+            visible[i] = 0;
+            ++culled;
+        }
+    }
+    return culled;
+}
+
+void OcclusionCuller::raster_triangle(const ScreenVert& a, const ScreenVert& b0, const ScreenVert& c0, int y0, int y1)
+{
+    ScreenVert b = b0;
+    ScreenVert c = c0;
+
+    float area = (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
+    if (std::fabs(area) < 1e-6f) return;
+    if (area < 0.0f) {
+        std::swap(b, c);
+        area = -area;
+    }
+
+    const int min_x = std::max(0, static_cast<int>(std::floor(std::min({ a.x, b.x, c.x }))));
+    const int max_x = std::min(WIDTH - 1, static_cast<int>(std::ceil(std::max({ a.x, b.x, c.x }))));
+    const int min_y = std::max(y0, static_cast<int>(std::floor(std::min({ a.y, b.y, c.y }))));
+    const int max_y = std::min(y1 - 1, static_cast<int>(std::ceil(std::max({ a.y, b.y, c.y }))));
+    if (min_x > max_x || min_y > max_y) return;
+
+    // 1/w is linear in screen space
+    const float dzdx = ((b.inv_w - a.inv_w) * (c.y - a.y) - (c.inv_w - a.inv_w) * (b.y - a.y)) / area;
+    const float dzdy = ((c.inv_w - a.inv_w) * (b.x - a.x) - (b.inv_w - a.inv_w) * (c.x - a.x)) / area;
+
+    // Edge functions, >= 0 inside; stepping one pixel in x adds d*
+    const auto edge = [](const ScreenVert& p, const ScreenVert& q, float x, float y) {
+        return (q.x - p.x) * (y - p.y) - (q.y - p.y) * (x - p.x);
+    };
+    const float d0 = -(b.y - a.y);
+    const float d1 = -(c.y - b.y);
+    const float d2 = -(a.y - c.y);
+
+    std::vector<float>& depth = m_min[0];
+    const int span = max_x - min_x + 1;
+    const float px = static_cast<float>(min_x) + 0.5f;
+
+    for (int y = min_y; y <= max_y; ++y) {
+        const float py = static_cast<float>(y) + 0.5f;
+        const float e0 = edge(a, b, px, py);
+        const float e1 = edge(b, c, px, py);
+        const float e2 = edge(c, a, px, py);
+        const float z0 = a.inv_w + dzdx * (px - a.x) + dzdy * (py - a.y);
+
+        // Branch-free so the span loop vectorizes
+        float* out = depth.data() + static_cast<size_t>(y) * WIDTH + min_x;
+        for (int i = 0; i < span; ++i) {
+            const float fi = static_cast<float>(i);
+            const bool inside = (e0 + fi * d0 >= 0.0f) & (e1 + fi * d1 >= 0.0f) & (e2 + fi * d2 >= 0.0f);
+            const float z = z0 + fi * dzdx;
+            out[i] = inside ? std::max(out[i], z) : out[i];
+        }
+    }
+}
+
+void OcclusionCuller::raster_band(int y0, int y1, size_t& reached, double deadline_ms)
+{
+    const auto t0 = std::chrono::steady_clock::now();
+
+    for (size_t i = 0; i < m_projected.size(); ++i) {
+        if ((i & 7) == 0 && ms_since(t0) > deadline_ms) {
+            reached = i;
+            return;
+        }
+
+        const Projected& p = m_projected[i];
+        if (p.y1 < y0 || p.y0 >= y1) continue;
+
+        for (int f = 0; f < 6; ++f) {
+            if (!(p.faces & (1u << f))) continue;
+
+            const int* q = FACE_CORNERS[f];
+            raster_triangle(p.corners[q[0]], p.corners[q[1]], p.corners[q[2]], y0, y1);
+            raster_triangle(p.corners[q[0]], p.corners[q[2]], p.corners[q[3]], y0, y1);
+        }
+    }
+    reached = m_projected.size();
+}
+
+void OcclusionCuller::build_pyramid()
+{
+    for (int l = 1; l < LEVELS; ++l) {
+        const int w = WIDTH >> l;
+        const int h = HEIGHT >> l;
+        const int sw = WIDTH >> (l - 1);
+
+        const std::vector<float>& src_min = m_min[l - 1];
+        const std::vector<float>& src_max = (l == 1) ? m_min[0] : m_max[l - 1];
+
+        for (int y = 0; y < h; ++y) {
+            for (int x = 0; x < w; ++x) {
+                const size_t s0 = static_cast<size_t>(2 * y) * sw + 2 * x;
+                const size_t s1 = s0 + sw;
+                m_min[l][static_cast<size_t>(y) * w + x] =
+                    std::min(std::min(src_min[s0], src_min[s0 + 1]), std::min(src_min[s1], src_min[s1 + 1]));
+                m_max[l][static_cast<size_t>(y) * w + x] =
+                    std::max(std::max(src_max[s0], src_max[s0 + 1]), std::max(src_max[s1], src_max[s1 + 1]));
+            }
+        }
+    }
+}
+
+bool OcclusionCuller::section_visible(const glm::mat4& view_proj, const SectionDraw& s, bool& in_frustum) const
+{
+    in_frustum = true;
+
+    std::array<glm::vec4, 8> clip;
+    int out_l = 0, out_r = 0, out_b = 0, out_t = 0, out_n = 0, out_f = 0;
+    bool crosses_near = false;
+    for (int i = 0; i < 8; ++i) {
+        const glm::vec4 c = view_proj * glm::vec4(box_corner(s.min, s.max, i), 1.0f);
+        clip[i] = c;
+        out_l += c.x < -c.w;
+        out_r += c.x > c.w;
+        out_b += c.y < -c.w;
+        out_t += c.y > c.w;
+        out_n += c.z < -c.w;
+        out_f += c.z > c.w;
+        crosses_near = crosses_near || c.w < NEAR_W;
+    }
+
+    if (out_l == 8 || out_r == 8 || out_b == 8 || out_t == 8 || out_n == 8 || out_f == 8) {
+        in_frustum = false;
+        return false;
+    }
+    if (crosses_near) return true;
+
+    float min_x = 1e30f, max_x = -1e30f, min_y = 1e30f, max_y = -1e30f;
+    float nearest = 0.0f;
+    for (const glm::vec4& c : clip) {
+        const float inv_w = 1.0f / c.w;
+        const float sx = (c.x * inv_w * 0.5f + 0.5f) * WIDTH;
+        const float sy = (c.y * inv_w * 0.5f + 0.5f) * HEIGHT;
+        min_x = std::min(min_x, sx);
+        max_x = std::max(max_x, sx);
+        min_y = std::min(min_y, sy);
+        max_y = std::max(max_y, sy);
+        nearest = std::max(nearest, inv_w);
+    }
+
+    const int x0 = std::max(0, static_cast<int>(std::floor(min_x)));
+    const int x1 = std::min(WIDTH - 1, static_cast<int>(std::floor(max_x)));
+    const int y0 = std::max(0, static_cast<int>(std::floor(min_y)));
+    const int y1 = std::min(HEIGHT - 1, static_cast<int>(std::floor(max_y)));
+    if (x0 > x1 || y0 > y1) return true;
+
+    // Start at the level where the rect spans at most 2x2 tiles and refine
+    // while some tile is undecided.
+    int l = 0;
+    while (l < LEVELS - 1 && ((x1 >> l) - (x0 >> l) > 1 || (y1 >> l) - (y0 >> l) > 1)) ++l;
+
+    for (;;) {
+        const int w = WIDTH >> l;
+        bool undecided = false;
+
+        for (int ty = y0 >> l; ty <= (y1 >> l); ++ty) {
+            for (int tx = x0 >> l; tx <= (x1 >> l); ++tx) {
+                const size_t i = static_cast<size_t>(ty) * w + tx;
+                const float farthest = m_min[l][i];
+                if (nearest < farthest) continue;       // behind everything in this tile
+
+                const float closest = (l == 0) ? farthest : m_max[l][i];
+                if (nearest >= closest) return true;    // in front of everything in this tile
+                undecided = true;
+            }
+        }
+
+        if (!undecided) return false;
+
+        if (l == 0) return true;
+        --l;
+        if (((x1 >> l) - (x0 >> l) + 1) * ((y1 >> l) - (y0 >> l) + 1) > 64) return true;
+    }
+}
+
+void OcclusionCuller::cull(const glm::mat4& view_proj, const glm::vec3& eye,
+    const std::vector<SectionDraw>& sections, std::vector<uint8_t>& visible, double budget_ms)
+{
+    const auto t0 = std::chrono::steady_clock::now();
+
+    m_stats = OcclusionStats{};
+    m_stats.sections_tested = static_cast<uint32_t>(sections.size());
+    visible.assign(sections.size(), 1);
+
+    // Project occluders; anything crossing the near plane or off screen is dropped
+    m_projected.clear();
+    for (const OccluderBox& b : m_occluders) {
+        Projected p;
+        if (eye.x < b.min.x) p.faces |= 1u << 0;
+        if (eye.x > b.max.x) p.faces |= 1u << 1;
+        if (eye.y < b.min.y) p.faces |= 1u << 2;
+        if (eye.y > b.max.y) p.faces |= 1u << 3;
+        if (eye.z < b.min.z) p.faces |= 1u << 4;
+        if (eye.z > b.max.z) p.faces |= 1u << 5;
+
+        bool usable = p.faces != 0;
+        float min_x = 1e30f, max_x = -1e30f, min_y = 1e30f, max_y = -1e30f;
+        p.near_w = 1e30f;
+        for (int i = 0; i < 8 && usable; ++i) {
+            const glm::vec4 c = view_proj * glm::vec4(box_corner(b.min, b.max, i), 1.0f);
+            if (c.w < NEAR_W) {
+                usable = false;
+                break;
+            }
+            ScreenVert& v = p.corners[i];
+            v.inv_w = 1.0f / c.w;
+            v.x = (c.x * v.inv_w * 0.5f + 0.5f) * WIDTH;
+            v.y = (c.y * v.inv_w * 0.5f + 0.5f) * HEIGHT;
+            min_x = std::min(min_x, v.x);
+            max_x = std::max(max_x, v.x);
+            min_y = std::min(min_y, v.y);
+            max_y = std::max(max_y, v.y);
+            p.near_w = std::min(p.near_w, c.w);
+        }
+
+        if (!usable || max_x < 0.0f || min_x >= WIDTH || max_y < 0.0f || min_y >= HEIGHT) {
+            ++m_stats.occluders_skipped;
+            continue;
+        }
+
+        p.y0 = std::max(0, static_cast<int>(std::floor(min_y)));
+        p.y1 = std::min(HEIGHT - 1, static_cast<int>(std::ceil(max_y)));
+        m_projected.push_back(p);
+    }
+
+    // Nearest first: if the budget runs out, the biggest occluders are in
+    std::sort(m_projected.begin(), m_projected.end(),
+        [](const Projected& a, const Projected& b) { return a.near_w < b.near_w; });
+
+    std::fill(m_min[0].begin(), m_min[0].end(), 0.0f);
+
+    // Each band owns its rows of the depth buffer, so no two threads touch a pixel
+    const int bands = std::clamp(m_pool.size(), 1, 8);
+    const int band_rows = (HEIGHT + bands - 1) / bands;
+    std::array<size_t, 8> reached{};
+    const double raster_budget = budget_ms * 0.75 - ms_since(t0);
+
+    m_pool.parallel_for(bands, [&](int band) {
+        raster_band(band * band_rows, std::min(HEIGHT, (band + 1) * band_rows), reached[band], raster_budget);
+    });
+
+    size_t drawn = m_projected.size();
+    for (int b = 0; b < bands; ++b) drawn = std::min(drawn, reached[b]);
+    m_stats.occluders_drawn = static_cast<uint32_t>(drawn);
+    m_stats.occluders_skipped += static_cast<uint32_t>(m_projected.size() - drawn);
+    m_stats.over_budget = drawn < m_projected.size();
+
+    build_pyramid();
+    m_stats.raster_ms = ms_since(t0);
+
+    // Test sections in batches; batches started after the budget stay visible
+    constexpr int BATCH = 64;
+    const int batches = static_cast<int>((sections.size() + BATCH - 1) / BATCH);
+    std::atomic<uint32_t> frustum_culled{ 0 };
+    std::atomic<uint32_t> occlusion_culled{ 0 };
+    std::atomic<bool> over_budget{ false };
+
+    m_pool.parallel_for(batches, [&](int batch) {
+        if (ms_since(t0) > budget_ms) {
+            over_budget.store(true, std::memory_order_relaxed);
+            return;
+        }
+
+        const size_t end = std::min(sections.size(), static_cast<size_t>(batch + 1) * BATCH);
+        for (size_t i = static_cast<size_t>(batch) * BATCH; i < end; ++i) {
+            bool in_frustum = true;
+            if (section_visible(view_proj, sections[i], in_frustum)) continue;
+
+            visible[i] = 0;
+            if (in_frustum) occlusion_culled.fetch_add(1, std::memory_order_relaxed);
+            else frustum_culled.fetch_add(1, std::memory_order_relaxed);
+        }
+    });
+
+    m_stats.frustum_culled = frustum_culled.load();
+    m_stats.occlusion_culled = occlusion_culled.load();
+    m_stats.over_budget = m_stats.over_budget || over_budget.load();
+    m_stats.test_ms = ms_since(t0) - m_stats.raster_ms;
+}
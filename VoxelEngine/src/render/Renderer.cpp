@@ -1,12 +1,23 @@
 #include "render/Renderer.h"
 
+#include <algorithm>
 #include <cstddef> // offsetof
+#include <cstdint>
+#include <cstring>
 #include <iostream>
 
 #include <glad/glad.h>
 
 #include <glm/gtc/type_ptr.hpp>
 
+namespace {
+
+// Initial arena sizes; both double when full
+constexpr size_t INITIAL_VERTICES = 256 * 1024;
+constexpr size_t INITIAL_INDICES = 384 * 1024;
+
+} // namespace
+
 Renderer::~Renderer()
 {
     if (m_vao) glDeleteVertexArrays(1, &m_vao);
@@ -16,10 +27,14 @@ Renderer::~Renderer()
     m_vao = 0;
     m_vbo = 0;
     m_ebo = 0;
-    m_index_count = 0;
+
+    if (m_gpu_bytes) {
+        mem_track_free(MemCategory::GpuBuffers, m_gpu_bytes, 2);
+        m_gpu_bytes = 0;
+    }
 }
 
-bool Renderer::init()
+bool Renderer::init(size_t staging_bytes)
 {
     const char* vs_source = R"GLSL(
 #version 450 core
@@ -59,20 +74,30 @@ void main()
     vec3 light_dir = normalize(vec3(0.4, 1.0, 0.2));
     float ndotl = max(dot(n, light_dir), 0.0);
 
-    vec3 albedo = texture(u_tex, vec3(v_uv, float(v_layer))).rgb;
+    // Transparent blocks are cut out: no blending, so no sorting needed
+    vec4 texel = texture(u_tex, vec3(v_uv, float(v_layer)));
+    if (texel.a < 0.5) discard;
+
+    vec3 albedo = texel.rgb;
     vec3 color = albedo * (0.25 + 0.75 * ndotl);
 
     frag_color = vec4(color, 1.0);
 }
 )GLSL";
 
-    if (!m_prog.build_from_sources(vs_source, fs_source)) {
+    m_shader_cache.init();
+
+    if (!m_prog.build_from_sources(vs_source, fs_source, &m_shader_cache)) {
         return false;
     }
 
     m_u_mvp = m_prog.uniform_location("u_mvp");
 
-    if (!m_tex.create_grass_stone_16()) {
+    if (!m_tex.create_block_textures_16()) {
+        return false;
+    }
+
+    if (!m_staging.init(staging_bytes)) {
         return false;
     }
 
@@ -80,15 +105,15 @@ void main()
     glCreateBuffers(1, &m_vbo);
     glCreateBuffers(1, &m_ebo);
 
-    return true;
-}
-
-void Renderer::upload_mesh(const std::vector<Vertex>& verts, const std::vector<uint32_t>& inds)
-{
-    m_index_count = static_cast<GLsizei>(inds.size());
+    const size_t vbo_bytes = INITIAL_VERTICES * sizeof(Vertex);
+    const size_t ebo_bytes = INITIAL_INDICES * sizeof(uint32_t);
+    glNamedBufferStorage(m_vbo, static_cast<GLsizeiptr>(vbo_bytes), nullptr, GL_DYNAMIC_STORAGE_BIT);
+    glNamedBufferStorage(m_ebo, static_cast<GLsizeiptr>(ebo_bytes), nullptr, GL_DYNAMIC_STORAGE_BIT);
+    m_vertex_arena.grow(INITIAL_VERTICES);
+    m_index_arena.grow(INITIAL_INDICES);
 
-    glNamedBufferData(m_vbo, static_cast<GLsizeiptr>(verts.size() * sizeof(Vertex)), verts.data(), GL_STATIC_DRAW);
-    glNamedBufferData(m_ebo, static_cast<GLsizeiptr>(inds.size() * sizeof(uint32_t)), inds.data(), GL_STATIC_DRAW);
+    m_gpu_bytes = vbo_bytes + ebo_bytes;
+    mem_track_alloc(MemCategory::GpuBuffers, m_gpu_bytes, 2);
 
     glVertexArrayVertexBuffer(m_vao, 0, m_vbo, 0, static_cast<GLsizei>(sizeof(Vertex)));
     glVertexArrayElementBuffer(m_vao, m_ebo);
@@ -112,15 +137,157 @@ void Renderer::upload_mesh(const std::vector<Vertex>& verts, const std::vector<u
     glEnableVertexArrayAttrib(m_vao, 3);
     glVertexArrayAttribIFormat(m_vao, 3, 1, GL_UNSIGNED_INT, static_cast<GLuint>(offsetof(Vertex, layer)));
     glVertexArrayAttribBinding(m_vao, 3, 0);
+
+    return true;
+}
+
+// Finds `count` elements in the arena, doubling the buffer (a GPU-side copy)
+// until they fit.
+bool Renderer::reserve(BufferArena& arena, GLuint& buffer, size_t elem_bytes, size_t count, size_t& offset)
+{
+    offset = arena.alloc(count);
+    if (offset != BufferArena::INVALID) return true;
+
+    const size_t old_capacity = arena.capacity();
+    size_t capacity = old_capacity;
+    while (offset == BufferArena::INVALID) {
+        capacity *= 2;
+        arena.grow(capacity);
+        offset = arena.alloc(count);
+    }
+
+    GLuint grown = 0;
+    glCreateBuffers(1, &grown);
+    glNamedBufferStorage(grown, static_cast<GLsizeiptr>(capacity * elem_bytes), nullptr, GL_DYNAMIC_STORAGE_BIT);
+    glCopyNamedBufferSubData(buffer, grown, 0, 0, static_cast<GLsizeiptr>(old_capacity * elem_bytes));
+    glDeleteBuffers(1, &buffer);
+    buffer = grown;
+
+    if (&buffer == &m_vbo) glVertexArrayVertexBuffer(m_vao, 0, m_vbo, 0, static_cast<GLsizei>(sizeof(Vertex)));
+    else glVertexArrayElementBuffer(m_vao, m_ebo);
+
+    mem_track_free(MemCategory::GpuBuffers, m_gpu_bytes, 2);
+    m_gpu_bytes += (capacity - old_capacity) * elem_bytes;
+    mem_track_alloc(MemCategory::GpuBuffers, m_gpu_bytes, 2);
+    return true;
+}
+
+void Renderer::insert_draw(const SectionDraw& d)
+{
+    const auto at = std::lower_bound(m_draws.begin(), m_draws.end(), d.first_index,
+        [](const SectionDraw& a, uint32_t first) { return a.first_index < first; });
+    m_draws.insert(at, d);
 }
 
-void Renderer::render(const glm::mat4& mvp)
+void Renderer::remove_section(uint32_t section)
 {
+    if (section >= m_resident.size() || !m_resident[section].resident) return;
+
+    Resident& r = m_resident[section];
+    const auto it = std::find_if(m_draws.begin(), m_draws.end(), [section](const SectionDraw& d) { return d.section == section; });
+    m_index_arena.free(it->first_index, it->index_count);
+    m_vertex_arena.free(r.first_vertex, r.vertex_count);
+    m_draws.erase(it);
+    r = Resident{};
+}
+
+bool Renderer::upload_section(const SectionMesh& mesh)
+{
+    const uint32_t section = mesh.bounds.section;
+    if (mesh.inds.empty()) {
+        remove_section(section);
+        return true;
+    }
+
+    const size_t vbytes = mesh.verts.size() * sizeof(Vertex);
+    const size_t ibytes = mesh.inds.size() * sizeof(uint32_t);
+    const bool direct = vbytes + ibytes > m_staging.segment_bytes();
+
+    size_t staged = 0;
+    uint8_t* dst = nullptr;
+    if (!direct) {
+        dst = m_staging.alloc(vbytes + ibytes, staged);
+        if (!dst) return false;
+    }
+
+    remove_section(section);
+
+    // The old buffers stay valid for everything queued before a regrow
+    size_t first_vertex = 0;
+    size_t first_index = 0;
+    reserve(m_vertex_arena, m_vbo, sizeof(Vertex), mesh.verts.size(), first_vertex);
+    reserve(m_index_arena, m_ebo, sizeof(uint32_t), mesh.inds.size(), first_index);
+
+    const uint32_t base = static_cast<uint32_t>(first_vertex);
+    const GLintptr vbo_at = static_cast<GLintptr>(first_vertex * sizeof(Vertex));
+    const GLintptr ebo_at = static_cast<GLintptr>(first_index * sizeof(uint32_t));
+
+    if (direct) {
+        MeshIndices rebased(mesh.inds.size());
+        for (size_t i = 0; i < mesh.inds.size(); ++i) rebased[i] = mesh.inds[i] + base;
+        glNamedBufferSubData(m_vbo, vbo_at, static_cast<GLsizeiptr>(vbytes), mesh.verts.data());
+        glNamedBufferSubData(m_ebo, ebo_at, static_cast<GLsizeiptr>(ibytes), rebased.data());
+    }
+    else {
+        std::memcpy(dst, mesh.verts.data(), vbytes);
+        uint32_t* inds = reinterpret_cast<uint32_t*>(dst + vbytes);
+        for (size_t i = 0; i < mesh.inds.size(); ++i) inds[i] = mesh.inds[i] + base;
+
+        const GLuint ring = m_staging.buffer();
+        glCopyNamedBufferSubData(ring, m_vbo, static_cast<GLintptr>(staged), vbo_at, static_cast<GLsizeiptr>(vbytes));
+        glCopyNamedBufferSubData(ring, m_ebo, static_cast<GLintptr>(staged + vbytes), ebo_at, static_cast<GLsizeiptr>(ibytes));
+    }
+
+    if (section >= m_resident.size()) m_resident.resize(section + 1);
+    m_resident[section] = Resident{ first_vertex, mesh.verts.size(), true };
+
+    SectionDraw d = mesh.bounds;
+    d.first_index = static_cast<uint32_t>(first_index);
+    d.index_count = static_cast<uint32_t>(mesh.inds.size());
+    insert_draw(d);
+    return true;
+}
+
+void Renderer::render(const glm::mat4& mvp, const std::vector<SectionDraw>& sections, const std::vector<uint8_t>& visible)
+{
+    m_draw_counts.clear();
+    m_draw_offsets.clear();
+
+    RenderStats stats;
+
+    // Sections are stored back to back; consecutive visible ones become one range
+    uint32_t run_first = 0;
+    uint32_t run_end = 0;
+    const auto flush = [&] {
+        if (run_end == run_first) return;
+        m_draw_counts.push_back(static_cast<GLsizei>(run_end - run_first));
+        m_draw_offsets.push_back(reinterpret_cast<const void*>(static_cast<uintptr_t>(run_first) * sizeof(uint32_t)));
+        stats.indices += run_end - run_first;
+    };
+
+    for (size_t i = 0; i < sections.size() && i < visible.size(); ++i) {
+        if (!visible[i]) continue;
+
+        const SectionDraw& d = sections[i];
+        if (d.first_index != run_end) {
+            flush();
+            run_first = d.first_index;
+        }
+        run_end = d.first_index + d.index_count;
+        ++stats.sections_drawn;
+    }
+    flush();
+
+    stats.draw_calls = static_cast<uint32_t>(m_draw_counts.size());
+    m_stats = stats;
+    if (m_draw_counts.empty()) return;
+
     m_prog.use();
     glUniformMatrix4fv(m_u_mvp, 1, GL_FALSE, glm::value_ptr(mvp));
 
     m_tex.bind_unit(0);
 
     glBindVertexArray(m_vao);
-    glDrawElements(GL_TRIANGLES, m_index_count, GL_UNSIGNED_INT, nullptr);
+    glMultiDrawElements(GL_TRIANGLES, m_draw_counts.data(), GL_UNSIGNED_INT,
+        m_draw_offsets.data(), static_cast<GLsizei>(m_draw_counts.size()));
 }
@@ -0,0 +1,147 @@
+#include "render/ShaderCache.h"
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+namespace {
+
+constexpr uint32_t CACHE_MAGIC = 0x42505856u; // "VXPB"
+constexpr uint32_t CACHE_VERSION = 1u;
+
+struct CacheHeader
+{
+    uint32_t magic;
+    uint32_t version;
+    uint64_t key;
+    uint32_t format;
+    uint32_t size;
+};
+
+uint64_t fnv1a(uint64_t h, const char* s)
+{
+    if (s) {
+        for (; *s; ++s) {
+            h ^= static_cast<uint8_t>(*s);
+            h *= 0x100000001B3ull;
+        }
+    }
+    // Separator so ("ab", "c") and ("a", "bc") hash differently
+    h ^= 0xFFu;
+    h *= 0x100000001B3ull;
+    return h;
+}
+
+const char* gl_string(GLenum name)
+{
+    const GLubyte* s = glGetString(name);
+    return s ? reinterpret_cast<const char*>(s) : "";
+}
+
+} // namespace
+
+ShaderCache::ShaderCache(std::string dir)
+    : m_dir(std::move(dir))
+{
+}
+
+void ShaderCache::init()
+{
+    GLint formats = 0;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+    if (formats <= 0) {
+        std::cout << "Shader cache: driver exposes no program binary formats, disabled\n";
+        m_enabled = false;
+        return;
+    }
+
+    m_driver_id = std::string(gl_string(GL_VENDOR)) + "|" + gl_string(GL_RENDERER) + "|" + gl_string(GL_VERSION);
+
+    std::error_code ec;
+    std::filesystem::create_directories(m_dir, ec);
+    m_enabled = !ec;
+    if (ec) {
+        std::cerr << "Shader cache: cannot create '" << m_dir << "': " << ec.message() << "\n";
+    }
+}
+
+uint64_t ShaderCache::key_for(const char* vs_source, const char* fs_source) const
+{
+    uint64_t h = 0xCBF29CE484222325ull;
+    h = fnv1a(h, vs_source);
+    h = fnv1a(h, fs_source);
+    h = fnv1a(h, m_driver_id.c_str());
+    return h;
+}
+
+std::string ShaderCache::path_for(uint64_t key) const
+{
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx.bin", static_cast<unsigned long long>(key));
+    return (std::filesystem::path(m_dir) / name).string();
+}
+
+bool ShaderCache::load(GLuint prog, uint64_t key) const
+{
+    if (!m_enabled) return false;
+
+    std::ifstream in(path_for(key), std::ios::binary);
+    if (!in) return false;
+
+    CacheHeader hdr{};
+    if (!in.read(reinterpret_cast<char*>(&hdr), sizeof(hdr)) ||
+        hdr.magic != CACHE_MAGIC || hdr.version != CACHE_VERSION ||
+        hdr.key != key || hdr.size == 0) {
+        return false;
+    }
+
+    std::vector<char> binary(hdr.size);
+    if (!in.read(binary.data(), static_cast<std::streamsize>(binary.size()))) {
+        return false;
+    }
+
+    glProgramBinary(prog, static_cast<GLenum>(hdr.format), binary.data(), static_cast<GLsizei>(binary.size()));
+
+    // Drivers may reject binaries from other builds; that is a cache miss, not an error.
+    GLint ok = GL_FALSE;
+    glGetProgramiv(prog, GL_LINK_STATUS, &ok);
+    return ok == GL_TRUE;
+}
+
+void ShaderCache::store(GLuint prog, uint64_t key) const
+{
+    if (!m_enabled) return;
+
+    GLint len = 0;
+    glGetProgramiv(prog, GL_PROGRAM_BINARY_LENGTH, &len);
+    if (len <= 0) return;
+
+    std::vector<char> binary(static_cast<size_t>(len));
+    GLenum format = 0;
+    GLsizei written = 0;
+    glGetProgramBinary(prog, len, &written, &format, binary.data());
+    if (written <= 0) return;
+
+    const CacheHeader hdr{ CACHE_MAGIC, CACHE_VERSION, key, static_cast<uint32_t>(format), static_cast<uint32_t>(written) };
+
+    // Write to a temp file and rename so a crash never leaves a torn entry.
+    const std::string path = path_for(key);
+    const std::string tmp = path + ".tmp";
+    {
+        std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+        if (!out) return;
+        out.write(reinterpret_cast<const char*>(&hdr), sizeof(hdr));
+        out.write(binary.data(), written);
+        if (!out) return;
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(tmp, path, ec);
+    if (ec) {
+        std::filesystem::remove(tmp, ec);
+    }
+}
@@ -0,0 +1,79 @@
+#include "render/StagingRing.h"
+#include "core/MemoryStats.h"
+
+#include <iostream>
+
+namespace {
+
+constexpr size_t ALIGN = 16;
+
+} // namespace
+
+StagingRing::~StagingRing()
+{
+    for (GLsync& f : m_fences) {
+        if (f) glDeleteSync(f);
+        f = nullptr;
+    }
+
+    if (m_buffer) {
+        glUnmapNamedBuffer(m_buffer);
+        glDeleteBuffers(1, &m_buffer);
+        mem_track_free(MemCategory::GpuBuffers, m_segment_bytes * SEGMENTS);
+    }
+}
+
+bool StagingRing::init(size_t bytes)
+{
+    m_segment_bytes = (bytes / SEGMENTS) & ~(ALIGN - 1);
+    const size_t total = m_segment_bytes * SEGMENTS;
+
+    const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+    glCreateBuffers(1, &m_buffer);
+    glNamedBufferStorage(m_buffer, static_cast<GLsizeiptr>(total), nullptr, flags);
+    m_mapped = static_cast<uint8_t*>(glMapNamedBufferRange(m_buffer, 0, static_cast<GLsizeiptr>(total), flags));
+    if (!m_mapped) {
+        std::cerr << "Failed to map the staging buffer\n";
+        glDeleteBuffers(1, &m_buffer);
+        m_buffer = 0;
+        return false;
+    }
+
+    mem_track_alloc(MemCategory::GpuBuffers, total);
+    return true;
+}
+
+uint8_t* StagingRing::alloc(size_t size, size_t& offset)
+{
+    if (!m_mapped) return nullptr;
+
+    if (!m_checked) {
+        GLsync& f = m_fences[m_segment];
+        if (f) {
+            const GLenum r = glClientWaitSync(f, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+            if (r != GL_ALREADY_SIGNALED && r != GL_CONDITION_SATISFIED) return nullptr;
+            glDeleteSync(f);
+            f = nullptr;
+        }
+        m_checked = true;
+    }
+
+    const size_t aligned = (size + ALIGN - 1) & ~(ALIGN - 1);
+    if (m_used + aligned > m_segment_bytes) return nullptr;
+
+    offset = static_cast<size_t>(m_segment) * m_segment_bytes + m_used;
+    m_used += aligned;
+    return m_mapped + offset;
+}
+
+void StagingRing::end_frame()
+{
+    if (m_used > 0) {
+        GLsync& f = m_fences[m_segment];
+        if (f) glDeleteSync(f);
+        f = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        m_segment = (m_segment + 1) % SEGMENTS;
+    }
+    m_used = 0;
+    m_checked = false;
+}
@@ -1,4 +1,6 @@
 #include "render/TextureArray.h"
+#include "core/MemoryStats.h"
+#include "world/BlockRegistry.h"
 
 #include <array>
 #include <algorithm>
@@ -61,31 +63,201 @@ static void make_stone_16x16(std::array<uint8_t, 16 * 16 * 4>& rgba)
     }
 }
 
+static void make_sand_16x16(std::array<uint8_t, 16 * 16 * 4>& rgba)
+{
+    uint32_t seed = 0x5A4D1E37u;
+
+    for (int y = 0; y < 16; ++y) {
+        for (int x = 0; x < 16; ++x) {
+            const int i = (y * 16 + x) * 4;
+
+            const uint32_t r = xorshift32(seed);
+            const int noise = static_cast<int>(r & 31u) - 15;
+
+            rgba[i + 0] = static_cast<uint8_t>(std::clamp(210 + noise, 0, 255));
+            rgba[i + 1] = static_cast<uint8_t>(std::clamp(190 + noise, 0, 255));
+            rgba[i + 2] = static_cast<uint8_t>(std::clamp(130 + noise / 2, 0, 255));
+            rgba[i + 3] = 255;
+        }
+    }
+}
+
+static void make_dirt_16x16(std::array<uint8_t, 16 * 16 * 4>& rgba)
+{
+    uint32_t seed = 0x2F6B9D13u;
+
+    for (int y = 0; y < 16; ++y) {
+        for (int x = 0; x < 16; ++x) {
+            const int i = (y * 16 + x) * 4;
+
+            const uint32_t r = xorshift32(seed);
+            const int noise = static_cast<int>(r & 31u) - 15;
+
+            rgba[i + 0] = static_cast<uint8_t>(std::clamp(110 + noise, 0, 255));
+            rgba[i + 1] = static_cast<uint8_t>(std::clamp(78 + noise, 0, 255));
+            rgba[i + 2] = static_cast<uint8_t>(std::clamp(50 + noise / 2, 0, 255));
+            rgba[i + 3] = 255;
+        }
+    }
+}
+
+// Dirt with a ragged grass fringe along the top rows (v = 1 is the top edge).
+static void make_grass_side_16x16(std::array<uint8_t, 16 * 16 * 4>& rgba)
+{
+    std::array<uint8_t, 16 * 16 * 4> grass{};
+    make_dirt_16x16(rgba);
+    make_grass_16x16(grass);
+
+    uint32_t seed = 0x7E1C5A29u;
+    for (int x = 0; x < 16; ++x) {
+        const int fringe = 3 + static_cast<int>(xorshift32(seed) % 3u);
+        for (int y = 16 - fringe; y < 16; ++y) {
+            const int i = (y * 16 + x) * 4;
+            std::copy(&grass[i], &grass[i] + 4, &rgba[i]);
+        }
+    }
+}
+
+// Pale frame, clear inside (alpha 0 is cut out by the shader).
+static void make_glass_16x16(std::array<uint8_t, 16 * 16 * 4>& rgba)
+{
+    for (int y = 0; y < 16; ++y) {
+        for (int x = 0; x < 16; ++x) {
+            const int i = (y * 16 + x) * 4;
+            const bool frame = x == 0 || y == 0 || x == 15 || y == 15 || (x == y && x > 3 && x < 8);
+
+            rgba[i + 0] = 200;
+            rgba[i + 1] = 225;
+            rgba[i + 2] = 235;
+            rgba[i + 3] = frame ? 255 : 0;
+        }
+    }
+}
+
+static void make_leaves_16x16(std::array<uint8_t, 16 * 16 * 4>& rgba)
+{
+    uint32_t seed = 0x91E4B7C3u;
+
+    for (int y = 0; y < 16; ++y) {
+        for (int x = 0; x < 16; ++x) {
+            const int i = (y * 16 + x) * 4;
+
+            const uint32_t r = xorshift32(seed);
+            const int noise = static_cast<int>(r & 31u) - 15;
+
+            rgba[i + 0] = static_cast<uint8_t>(std::clamp(30 + noise / 2, 0, 255));
+            rgba[i + 1] = static_cast<uint8_t>(std::clamp(105 + noise, 0, 255));
+            rgba[i + 2] = static_cast<uint8_t>(std::clamp(30 + noise / 3, 0, 255));
+            rgba[i + 3] = ((r >> 8) & 3u) == 0 ? 0 : 255;     // about a quarter see-through
+        }
+    }
+}
+
+static void make_water_16x16(std::array<uint8_t, 16 * 16 * 4>& rgba)
+{
+    uint32_t seed = 0x3C6EF372u;
+
+    for (int y = 0; y < 16; ++y) {
+        for (int x = 0; x < 16; ++x) {
+            const int i = (y * 16 + x) * 4;
+
+            const uint32_t r = xorshift32(seed);
+            const int noise = static_cast<int>(r & 15u) - 7;
+
+            rgba[i + 0] = static_cast<uint8_t>(std::clamp(40 + noise, 0, 255));
+            rgba[i + 1] = static_cast<uint8_t>(std::clamp(90 + noise, 0, 255));
+            rgba[i + 2] = static_cast<uint8_t>(std::clamp(190 + noise, 0, 255));
+            rgba[i + 3] = 255;
+        }
+    }
+}
+
+// Bark: dark vertical streaks.
+static void make_wood_side_16x16(std::array<uint8_t, 16 * 16 * 4>& rgba)
+{
+    uint32_t seed = 0x6D2B79F5u;
+
+    std::array<int, 16> streak{};
+    for (int x = 0; x < 16; ++x) streak[x] = static_cast<int>(xorshift32(seed) & 31u) - 15;
+
+    for (int y = 0; y < 16; ++y) {
+        for (int x = 0; x < 16; ++x) {
+            const int i = (y * 16 + x) * 4;
+            const int noise = streak[x] + static_cast<int>(xorshift32(seed) & 7u) - 3;
+
+            rgba[i + 0] = static_cast<uint8_t>(std::clamp(95 + noise, 0, 255));
+            rgba[i + 1] = static_cast<uint8_t>(std::clamp(68 + noise, 0, 255));
+            rgba[i + 2] = static_cast<uint8_t>(std::clamp(40 + noise / 2, 0, 255));
+            rgba[i + 3] = 255;
+        }
+    }
+}
+
+// Cut log: light wood with growth rings.
+static void make_wood_top_16x16(std::array<uint8_t, 16 * 16 * 4>& rgba)
+{
+    for (int y = 0; y < 16; ++y) {
+        for (int x = 0; x < 16; ++x) {
+            const int i = (y * 16 + x) * 4;
+            const int dx = 2 * x - 15;
+            const int dy = 2 * y - 15;
+            const int ring = (dx * dx + dy * dy) / 24 % 2 == 0 ? 0 : -25;
+
+            rgba[i + 0] = static_cast<uint8_t>(std::clamp(175 + ring, 0, 255));
+            rgba[i + 1] = static_cast<uint8_t>(std::clamp(140 + ring, 0, 255));
+            rgba[i + 2] = static_cast<uint8_t>(std::clamp(90 + ring, 0, 255));
+            rgba[i + 3] = 255;
+        }
+    }
+}
+
+using TextureMaker = void (*)(std::array<uint8_t, 16 * 16 * 4>&);
+
+// One maker per layer, in BlockTexture order.
+static constexpr TextureMaker BLOCK_TEXTURE_MAKERS[] = {
+    &make_grass_16x16,
+    &make_stone_16x16,
+    &make_sand_16x16,
+    &make_dirt_16x16,
+    &make_grass_side_16x16,
+    &make_glass_16x16,
+    &make_leaves_16x16,
+    &make_water_16x16,
+    &make_wood_side_16x16,
+    &make_wood_top_16x16,
+};
+
+static_assert(std::size(BLOCK_TEXTURE_MAKERS) == BLOCK_TEXTURE_COUNT, "one texture maker per BlockTexture");
+
+static constexpr int BLOCK_LAYERS = BLOCK_TEXTURE_COUNT;
+static constexpr size_t BLOCK_TEXTURE_BYTES = 16 * 16 * 4 * BLOCK_LAYERS;
+
 TextureArray::~TextureArray()
 {
     if (m_tex) {
         glDeleteTextures(1, &m_tex);
+        mem_track_free(MemCategory::GpuBuffers, BLOCK_TEXTURE_BYTES);
         m_tex = 0;
     }
 }
 
-bool TextureArray::create_grass_stone_16()
+bool TextureArray::create_block_textures_16()
 {
     if (m_tex) {
         glDeleteTextures(1, &m_tex);
+        mem_track_free(MemCategory::GpuBuffers, BLOCK_TEXTURE_BYTES);
         m_tex = 0;
     }
 
     glCreateTextures(GL_TEXTURE_2D_ARRAY, 1, &m_tex);
-    glTextureStorage3D(m_tex, 1, GL_RGBA8, 16, 16, 2);
-
-    std::array<uint8_t, 16 * 16 * 4> grass{};
-    std::array<uint8_t, 16 * 16 * 4> stone{};
-    make_grass_16x16(grass);
-    make_stone_16x16(stone);
+    glTextureStorage3D(m_tex, 1, GL_RGBA8, 16, 16, BLOCK_LAYERS);
+    mem_track_alloc(MemCategory::GpuBuffers, BLOCK_TEXTURE_BYTES);
 
-    glTextureSubImage3D(m_tex, 0, 0, 0, 0, 16, 16, 1, GL_RGBA, GL_UNSIGNED_BYTE, grass.data());
-    glTextureSubImage3D(m_tex, 0, 0, 0, 1, 16, 16, 1, GL_RGBA, GL_UNSIGNED_BYTE, stone.data());
+    std::array<uint8_t, 16 * 16 * 4> rgba{};
+    for (int layer = 0; layer < BLOCK_LAYERS; ++layer) {
+        BLOCK_TEXTURE_MAKERS[layer](rgba);
+        glTextureSubImage3D(m_tex, 0, 0, 0, layer, 16, 16, 1, GL_RGBA, GL_UNSIGNED_BYTE, rgba.data());
+    }
 
     glTextureParameteri(m_tex, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
     glTextureParameteri(m_tex, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
@@ -0,0 +1,200 @@
+#include "render/UploadScheduler.h"
+
+#include <algorithm>
+#include <array>
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+// False only if the box is entirely outside one clip plane.
+bool box_in_frustum(const glm::mat4& view_proj, const glm::vec3& min, const glm::vec3& max)
+{
+    std::array<glm::vec4, 8> c;
+    for (int i = 0; i < 8; ++i) {
+        const glm::vec3 p((i & 1) ? max.x : min.x, (i & 2) ? max.y : min.y, (i & 4) ? max.z : min.z);
+        c[i] = view_proj * glm::vec4(p, 1.0f);
+    }
+
+    for (int axis = 0; axis < 3; ++axis) {
+        for (const float sign : { -1.0f, 1.0f }) {
+            bool outside = true;
+            for (const glm::vec4& v : c) {
+                if (sign * v[axis] <= v.w) {
+                    outside = false;
+                    break;
+                }
+            }
+            if (outside) return false;
+        }
+    }
+    return true;
+}
+
+float distance2_to_box(const glm::vec3& p, const glm::vec3& min, const glm::vec3& max)
+{
+    const glm::vec3 d = glm::max(glm::max(min - p, p - max), glm::vec3(0.0f));
+    return glm::dot(d, d);
+}
+
+template <typename T>
+void grow_to(std::vector<T>& v, size_t key, const T& fill)
+{
+    if (key >= v.size()) v.resize(key + 1, fill);
+}
+
+} // namespace
+
+void UploadScheduler::submit(SectionMesh mesh)
+{
+    const uint32_t key = mesh.bounds.section;
+    grow_to(m_queued_at, key, -1);
+
+    const int32_t at = m_queued_at[key];
+    if (at >= 0) {
+        m_stats.queued_bytes -= m_queue[static_cast<size_t>(at)].bytes();
+        m_stats.queued_bytes += mesh.bytes();
+        m_queue[static_cast<size_t>(at)] = std::move(mesh);
+        ++m_stats.superseded;
+        return;
+    }
+
+    m_stats.queued_bytes += mesh.bytes();
+    m_queued_at[key] = static_cast<int32_t>(m_queue.size());
+    m_queue.push_back(std::move(mesh));
+    m_stats.queued = m_queue.size();
+    m_stats.peak_queued = std::max(m_stats.peak_queued, m_stats.queued);
+}
+
+void UploadScheduler::run(const glm::mat4& view_proj, const glm::vec3& eye, const UploadBudget& budget, const UploadFn& upload)
+{
+    m_stats.uploaded = 0;
+    m_stats.bytes = 0;
+    m_stats.ms = 0.0;
+    m_stats.ring_full = false;
+    if (m_queue.empty()) return;
+
+    const auto t0 = clock_type::now();
+
+    // Removals, then in view, then the rest; nearest first within a class
+    struct Entry
+    {
+        int rank;
+        float dist2;
+        uint32_t index;
+    };
+    std::vector<Entry> order;
+    order.reserve(m_queue.size());
+    for (size_t i = 0; i < m_queue.size(); ++i) {
+        const SectionMesh& m = m_queue[i];
+        const int rank = m.inds.empty() ? 0 : (box_in_frustum(view_proj, m.bounds.min, m.bounds.max) ? 1 : 2);
+        order.push_back(Entry{ rank, distance2_to_box(eye, m.bounds.min, m.bounds.max), static_cast<uint32_t>(i) });
+    }
+    std::sort(order.begin(), order.end(), [](const Entry& a, const Entry& b) {
+        return a.rank != b.rank ? a.rank < b.rank : a.dist2 < b.dist2;
+    });
+
+    std::vector<uint8_t> done(m_queue.size(), 0);
+    for (const Entry& e : order) {
+        const SectionMesh& m = m_queue[e.index];
+
+        if (m_stats.uploaded > 0) {
+            if (budget.bytes > 0 && m_stats.bytes + m.bytes() > budget.bytes) break;
+            if (budget.ms > 0.0 && std::chrono::duration<double, std::milli>(clock_type::now() - t0).count() >= budget.ms) break;
+        }
+
+        if (!upload(m)) {
+            m_stats.ring_full = true;
+            ++m_stats.ring_stalls;
+            break;
+        }
+
+        done[e.index] = 1;
+        ++m_stats.uploaded;
+        m_stats.bytes += m.bytes();
+
+        const uint32_t key = m.bounds.section;
+        grow_to(m_awaiting, key, Awaiting{});
+        Awaiting& a = m_awaiting[key];
+        if (!m.inds.empty() && m.track_latency) {
+            m_stats.awaiting_draw += a.active ? 0 : 1;
+            a = Awaiting{ m.completed, m.completed_frame, true };
+        }
+        else if (a.active) {
+            // Removed, or replaced untracked, before it was ever drawn
+            a.active = false;
+            --m_stats.awaiting_draw;
+        }
+    }
+
+    // Drop what went up, keeping the rest in submission order
+    size_t keep = 0;
+    for (size_t i = 0; i < m_queue.size(); ++i) {
+        if (done[i]) {
+            m_stats.queued_bytes -= m_queue[i].bytes();
+            m_queued_at[m_queue[i].bounds.section] = -1;
+            continue;
+        }
+        if (keep != i) m_queue[keep] = std::move(m_queue[i]);
+        m_queued_at[m_queue[keep].bounds.section] = static_cast<int32_t>(keep);
+        ++keep;
+    }
+    m_queue.resize(keep);
+
+    m_stats.queued = m_queue.size();
+    m_stats.total_uploaded += m_stats.uploaded;
+    m_stats.total_bytes += m_stats.bytes;
+    m_stats.ms = std::chrono::duration<double, std::milli>(clock_type::now() - t0).count();
+}
+
+void UploadScheduler::record_draws(const std::vector<SectionDraw>& draws, const std::vector<uint8_t>& drawn, uint64_t frame)
+{
+    if (m_stats.awaiting_draw == 0) return;
+
+    const auto now = clock_type::now();
+    bool sampled = false;
+    for (size_t i = 0; i < draws.size() && i < drawn.size(); ++i) {
+        if (!drawn[i]) continue;
+
+        const uint32_t key = draws[i].section;
+        if (key >= m_awaiting.size() || !m_awaiting[key].active) continue;
+
+        Awaiting& a = m_awaiting[key];
+        a.active = false;
+        --m_stats.awaiting_draw;
+
+        const double ms = std::chrono::duration<double, std::milli>(now - a.completed).count();
+        const double frames = static_cast<double>(frame - a.completed_frame);
+        if (m_latency_ms.size() < LATENCY_WINDOW) {
+            m_latency_ms.push_back(ms);
+            m_latency_frames.push_back(frames);
+        }
+        else {
+            m_latency_ms[m_latency_next] = ms;
+            m_latency_frames[m_latency_next] = frames;
+        }
+        m_latency_next = (m_latency_next + 1) % LATENCY_WINDOW;
+        sampled = true;
+    }
+
+    if (sampled) update_latency_stats();
+}
+
+void UploadScheduler::update_latency_stats()
+{
+    std::vector<double> sorted = m_latency_ms;
+    std::sort(sorted.begin(), sorted.end());
+
+    double sum_ms = 0.0;
+    double sum_frames = 0.0;
+    for (size_t i = 0; i < sorted.size(); ++i) {
+        sum_ms += sorted[i];
+        sum_frames += m_latency_frames[i];
+    }
+
+    const double n = static_cast<double>(sorted.size());
+    m_stats.latency_mean_ms = sum_ms / n;
+    m_stats.latency_mean_frames = sum_frames / n;
+    m_stats.latency_p95_ms = sorted[std::min(sorted.size() - 1, static_cast<size_t>(0.95 * n))];
+    m_stats.latency_max_ms = sorted.back();
+}
@@ -0,0 +1,147 @@
+#include "world/ChunkCompressor.h"
+#include "core/MemoryStats.h"
+
+#include <algorithm>
+#include <cstddef>
+
+ChunkCompressor::ChunkCompressor(World& world, uint32_t idle_frames)
+    : m_world(world), m_idle_frames(idle_frames),
+      m_queued(static_cast<size_t>(WORLD_CHUNKS_X) * WORLD_CHUNKS_Z * static_cast<size_t>(world.chunks_y()), 0)
+{
+    m_thread = std::thread([this] { worker_main(); });
+}
+
+ChunkCompressor::~ChunkCompressor()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_cv.notify_one();
+    m_thread.join();
+
+    for (const Job& j : m_pending) chunk_version_release(j.source);
+    for (const Job& j : m_done) {
+        chunk_version_release(j.source);
+        packed_chunk_release(j.packed);
+    }
+    mem_track_free(MemCategory::JobQueues, m_in_flight * sizeof(Job), static_cast<int64_t>(m_in_flight));
+}
+
+size_t ChunkCompressor::section_index(const SectionCoord& c) const
+{
+    return static_cast<size_t>(World::col_idx(c.cx, c.cz)) * static_cast<size_t>(m_world.chunks_y()) + static_cast<size_t>(c.cy);
+}
+
+void ChunkCompressor::update()
+{
+    publish_done();
+    queue_idle_sections();
+}
+
+void ChunkCompressor::flush()
+{
+    while (m_in_flight > 0) {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_done_cv.wait(lock, [this] { return !m_done.empty(); });
+        }
+        publish_done();
+    }
+}
+
+void ChunkCompressor::publish_done()
+{
+    std::vector<Job> done;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        done.swap(m_done);
+    }
+    mem_track_free(MemCategory::JobQueues, done.size() * sizeof(Job), static_cast<int64_t>(done.size()));
+
+    for (const Job& j : done) {
+        m_queued[section_index(j.at)] = 0;
+        --m_in_flight;
+
+        if (!j.packed) {
+            // Retried only after another idle period
+            ++m_stats.packs_failed;
+            m_world.section_at(j.at.cx, j.at.cy, j.at.cz).touched = m_world.frame();
+        }
+        else {
+            const size_t packed_bytes = j.packed->bytes();
+            if (m_world.commit_section_packed(j.at.cx, j.at.cy, j.at.cz, j.source, j.packed)) {
+                ++m_stats.sections_packed;
+                m_stats.raw_bytes += sizeof(j.source->blocks);
+                m_stats.packed_bytes += packed_bytes;
+            }
+            else {
+                ++m_stats.packs_discarded;
+            }
+        }
+        chunk_version_release(j.source);
+    }
+}
+
+void ChunkCompressor::queue_idle_sections()
+{
+    std::vector<Job> jobs;
+    const uint64_t frame = m_world.frame();
+
+    // One slice of the world per frame, sized so a full sweep takes
+    // idle_frames: a section goes cold at most twice its idle time after its
+    // last edit, and a frame never walks the whole world
+    const size_t total = m_queued.size();
+    const size_t slice = (total + m_idle_frames) / (static_cast<size_t>(m_idle_frames) + 1);
+    const size_t chunks_y = static_cast<size_t>(m_world.chunks_y());
+
+    for (size_t n = 0; n < slice; ++n, m_scan_next = (m_scan_next + 1) % total) {
+        const int col = static_cast<int>(m_scan_next / chunks_y);
+        const SectionCoord at{ col % WORLD_CHUNKS_X, static_cast<int>(m_scan_next % chunks_y), col / WORLD_CHUNKS_X };
+
+        const ChunkSection& sec = m_world.section_at(at.cx, at.cy, at.cz);
+        const ChunkVersion* v = sec.hot();
+        if (!v || frame - sec.touched < m_idle_frames) continue;
+
+        uint8_t& queued = m_queued[m_scan_next];
+        if (queued) continue;
+
+        queued = 1;
+        chunk_version_acquire(v);
+        jobs.push_back(Job{ at, v, nullptr });
+    }
+
+    if (jobs.empty()) return;
+
+    // A job counts as queued from here until publish_done() takes it back
+    m_in_flight += jobs.size();
+    mem_track_alloc(MemCategory::JobQueues, jobs.size() * sizeof(Job), static_cast<int64_t>(jobs.size()));
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_pending.insert(m_pending.end(), jobs.begin(), jobs.end());
+    }
+    m_cv.notify_one();
+}
+
+void ChunkCompressor::worker_main()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    for (;;) {
+        m_cv.wait(lock, [this] { return m_stop || !m_pending.empty(); });
+        if (m_stop) return;
+
+        // Small batches so update() can publish while a large backlog drains
+        constexpr size_t BATCH = 64;
+        const size_t n = std::min(m_pending.size(), BATCH);
+        std::vector<Job> jobs(m_pending.end() - static_cast<std::ptrdiff_t>(n), m_pending.end());
+        m_pending.resize(m_pending.size() - n);
+        lock.unlock();
+
+        // The held reference keeps each source alive; versions are immutable
+        for (Job& j : jobs) j.packed = pack_chunk(*j.source);
+
+        lock.lock();
+        m_done.insert(m_done.end(), jobs.begin(), jobs.end());
+        m_done_cv.notify_all();
+    }
+}
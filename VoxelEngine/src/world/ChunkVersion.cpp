@@ -0,0 +1,145 @@
+#include "world/ChunkVersion.h"
+
+#include <array>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <vector>
+
+namespace {
+
+constexpr size_t MAX_READER_SLOTS = 128;
+constexpr uint64_t IDLE = 0;
+
+std::atomic<uint64_t> g_epoch{ 1 };
+
+// Epoch announced by each reader slot, IDLE when outside a guard
+std::array<std::atomic<uint64_t>, MAX_READER_SLOTS> g_reader_epoch{};
+std::array<std::atomic<bool>, MAX_READER_SLOTS> g_slot_taken{};
+
+struct Retired
+{
+    const void* object;
+    void (*destroy)(const void*);
+    uint64_t epoch;
+};
+
+void destroy_version(const void* p)
+{
+    delete static_cast<const ChunkVersion*>(p);
+}
+
+std::mutex g_retired_mutex;
+std::vector<Retired> g_retired;
+
+// One slot per reader thread, returned when the thread exits
+struct ReaderSlot
+{
+    int index = -1;
+    int depth = 0;
+
+    ~ReaderSlot()
+    {
+        if (index >= 0) {
+            g_reader_epoch[index].store(IDLE);
+            g_slot_taken[index].store(false);
+        }
+    }
+
+    // Slots are held until their thread exits, so waiting for one could
+    // wait forever: running out is a hard error.
+    void claim()
+    {
+        for (size_t i = 0; i < MAX_READER_SLOTS; ++i) {
+            bool expected = false;
+            if (g_slot_taken[i].compare_exchange_strong(expected, true)) {
+                index = static_cast<int>(i);
+                return;
+            }
+        }
+        std::cerr << "ChunkReadGuard: more than " << MAX_READER_SLOTS << " reader threads\n";
+        std::abort();
+    }
+};
+
+thread_local ReaderSlot t_slot;
+
+} // namespace
+
+void chunk_version_acquire(const ChunkVersion* v)
+{
+    if (v) v->refs.fetch_add(1, std::memory_order_relaxed);
+}
+
+void chunk_version_release(const ChunkVersion* v)
+{
+    if (!v || v->refs.fetch_sub(1, std::memory_order_acq_rel) != 1) return;
+    chunk_retire(v, &destroy_version);
+}
+
+void chunk_retire(const void* p, void (*destroy)(const void*))
+{
+    std::lock_guard<std::mutex> lock(g_retired_mutex);
+    g_retired.push_back(Retired{ p, destroy, g_epoch.load() });
+}
+
+ChunkReadGuard::ChunkReadGuard()
+{
+    if (t_slot.depth++ > 0) return;
+    if (t_slot.index < 0) t_slot.claim();
+
+    // The pointer loads after the guard are only acquire, which a plain
+    // seq_cst store does not order against; the fence (paired with the one
+    // in chunk_versions_collect) keeps them after the announcement, so the
+    // collector either sees this reader or the reader sees the new pointers.
+    g_reader_epoch[t_slot.index].store(g_epoch.load());
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+}
+
+ChunkReadGuard::~ChunkReadGuard()
+{
+    if (--t_slot.depth > 0) return;
+    g_reader_epoch[t_slot.index].store(IDLE);
+}
+
+void chunk_versions_collect()
+{
+    // Readers that enter from now on announce a later epoch than anything retired so far
+    g_epoch.fetch_add(1);
+
+    // Pairs with the fence in ChunkReadGuard: pointers replaced before this
+    // point are invisible to any reader whose announcement is not seen below
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    uint64_t oldest_reader = UINT64_MAX;
+    for (const auto& e : g_reader_epoch) {
+        const uint64_t v = e.load();
+        if (v != IDLE && v < oldest_reader) oldest_reader = v;
+    }
+
+    std::vector<Retired> to_free;
+    {
+        std::lock_guard<std::mutex> lock(g_retired_mutex);
+        size_t keep = 0;
+        for (const Retired& r : g_retired) {
+            // A reader that announced epoch <= r.epoch may have loaded the pointer
+            if (r.epoch < oldest_reader) {
+                to_free.push_back(r);
+            }
+            else {
+                g_retired[keep++] = r;
+            }
+        }
+        g_retired.resize(keep);
+    }
+
+    for (const Retired& r : to_free) {
+        r.destroy(r.object);
+    }
+}
+
+size_t chunk_versions_pending()
+{
+    std::lock_guard<std::mutex> lock(g_retired_mutex);
+    return g_retired.size();
+}
@@ -17,6 +17,18 @@ static float hash2d_to_01(int x, int z, uint32_t seed)
     return static_cast<float>(h & 0x00FFFFFFu) / static_cast<float>(0x01000000u);
 }
 
+static float hash3d_to_01(int x, int y, int z, uint32_t seed)
+{
+    uint32_t h = seed;
+    h ^= static_cast<uint32_t>(x) * 0x9E3779B9u;
+    h ^= static_cast<uint32_t>(y) * 0x27D4EB2Fu;
+    h ^= static_cast<uint32_t>(z) * 0x85EBCA6Bu;
+    h ^= (h >> 16);
+    h *= 0xC2B2AE35u;
+    h ^= (h >> 16);
+    return static_cast<float>(h & 0x00FFFFFFu) / static_cast<float>(0x01000000u);
+}
+
 static float value_noise_2d(float x, float z, uint32_t seed)
 {
     const int x0 = static_cast<int>(std::floor(x));
@@ -40,6 +52,30 @@ static float value_noise_2d(float x, float z, uint32_t seed)
     return lerp(ab, cd, v);
 }
 
+static float value_noise_3d(float x, float y, float z, uint32_t seed)
+{
+    const int x0 = static_cast<int>(std::floor(x));
+    const int y0 = static_cast<int>(std::floor(y));
+    const int z0 = static_cast<int>(std::floor(z));
+
+    const float u = fade(x - static_cast<float>(x0));
+    const float v = fade(y - static_cast<float>(y0));
+    const float w = fade(z - static_cast<float>(z0));
+
+    const float c000 = hash3d_to_01(x0, y0, z0, seed);
+    const float c100 = hash3d_to_01(x0 + 1, y0, z0, seed);
+    const float c010 = hash3d_to_01(x0, y0 + 1, z0, seed);
+    const float c110 = hash3d_to_01(x0 + 1, y0 + 1, z0, seed);
+    const float c001 = hash3d_to_01(x0, y0, z0 + 1, seed);
+    const float c101 = hash3d_to_01(x0 + 1, y0, z0 + 1, seed);
+    const float c011 = hash3d_to_01(x0, y0 + 1, z0 + 1, seed);
+    const float c111 = hash3d_to_01(x0 + 1, y0 + 1, z0 + 1, seed);
+
+    const float a = lerp(lerp(c000, c100, u), lerp(c010, c110, u), v);
+    const float b = lerp(lerp(c001, c101, u), lerp(c011, c111, u), v);
+    return lerp(a, b, w);
+}
+
 float fbm_2d(float x, float z, uint32_t seed, int octaves, float lacunarity, float gain)
 {
     float amp = 1.0f;
@@ -57,12 +93,151 @@ float fbm_2d(float x, float z, uint32_t seed, int octaves, float lacunarity, flo
     return (norm > 0.0f) ? (sum / norm) : 0.0f;
 }
 
-int terrain_height_10_16(int gx, int gz)
+float fbm_3d(float x, float y, float z, uint32_t seed, int octaves, float lacunarity, float gain)
+{
+    float amp = 1.0f;
+    float freq = 1.0f;
+    float sum = 0.0f;
+    float norm = 0.0f;
+
+    for (int i = 0; i < octaves; ++i) {
+        sum += amp * value_noise_3d(x * freq, y * freq, z * freq, seed + static_cast<uint32_t>(i) * 1013u);
+        norm += amp;
+        amp *= gain;
+        freq *= lacunarity;
+    }
+
+    return (norm > 0.0f) ? (sum / norm) : 0.0f;
+}
+
+// Range of value_noise_3d over a box, or false if the box crosses too many
+// lattice cells. Inside a cell the noise is multilinear in the faded
+// coordinates, so its extremes lie on the corners of the box clipped to the cell.
+static bool value_noise_3d_range(float x0, float y0, float z0, float x1, float y1, float z1,
+    uint32_t seed, float& lo, float& hi)
+{
+    constexpr int MAX_CELLS = 8;    // per axis
+
+    const int cx0 = static_cast<int>(std::floor(x0));
+    const int cy0 = static_cast<int>(std::floor(y0));
+    const int cz0 = static_cast<int>(std::floor(z0));
+    const int cx1 = static_cast<int>(std::floor(x1));
+    const int cy1 = static_cast<int>(std::floor(y1));
+    const int cz1 = static_cast<int>(std::floor(z1));
+    if (cx1 - cx0 >= MAX_CELLS || cy1 - cy0 >= MAX_CELLS || cz1 - cz0 >= MAX_CELLS) return false;
+
+    // Faded [lo, hi] of the box inside cell c along one axis
+    const auto span = [](float a, float b, int c, float& f0, float& f1) {
+        f0 = fade(std::max(a - static_cast<float>(c), 0.0f));
+        f1 = fade(std::min(b - static_cast<float>(c), 1.0f));
+    };
+
+    lo = 1.0f;
+    hi = 0.0f;
+    for (int z = cz0; z <= cz1; ++z) {
+        float w[2];
+        span(z0, z1, z, w[0], w[1]);
+        for (int y = cy0; y <= cy1; ++y) {
+            float v[2];
+            span(y0, y1, y, v[0], v[1]);
+            for (int x = cx0; x <= cx1; ++x) {
+                float u[2];
+                span(x0, x1, x, u[0], u[1]);
+
+                const float c000 = hash3d_to_01(x, y, z, seed);
+                const float c100 = hash3d_to_01(x + 1, y, z, seed);
+                const float c010 = hash3d_to_01(x, y + 1, z, seed);
+                const float c110 = hash3d_to_01(x + 1, y + 1, z, seed);
+                const float c001 = hash3d_to_01(x, y, z + 1, seed);
+                const float c101 = hash3d_to_01(x + 1, y, z + 1, seed);
+                const float c011 = hash3d_to_01(x, y + 1, z + 1, seed);
+                const float c111 = hash3d_to_01(x + 1, y + 1, z + 1, seed);
+
+                for (int k = 0; k < 2; ++k) {
+                    for (int j = 0; j < 2; ++j) {
+                        for (int i = 0; i < 2; ++i) {
+                            const float a = lerp(lerp(c000, c100, u[i]), lerp(c010, c110, u[i]), v[j]);
+                            const float b = lerp(lerp(c001, c101, u[i]), lerp(c011, c111, u[i]), v[j]);
+                            const float n = lerp(a, b, w[k]);
+                            lo = std::min(lo, n);
+                            hi = std::max(hi, n);
+                        }
+                    }
+                }
+            }
+        }
+    }
+    return true;
+}
+
+void fbm_3d_bounds(float x0, float y0, float z0, float x1, float y1, float z1,
+    uint32_t seed, int octaves, float lacunarity, float gain, float& lo, float& hi)
+{
+    float amp = 1.0f;
+    float freq = 1.0f;
+    float sum_lo = 0.0f;
+    float sum_hi = 0.0f;
+    float norm = 0.0f;
+
+    for (int i = 0; i < octaves; ++i) {
+        // Octaves peak at different points, so summing their ranges is conservative
+        float olo = 0.0f;
+        float ohi = 1.0f;
+        if (!value_noise_3d_range(x0 * freq, y0 * freq, z0 * freq, x1 * freq, y1 * freq, z1 * freq,
+                seed + static_cast<uint32_t>(i) * 1013u, olo, ohi)) {
+            olo = 0.0f;
+            ohi = 1.0f;
+        }
+
+        sum_lo += amp * olo;
+        sum_hi += amp * ohi;
+        norm += amp;
+        amp *= gain;
+        freq *= lacunarity;
+    }
+
+    // Small slack so float rounding in the blends can never escape the range
+    constexpr float EPS = 1e-4f;
+    lo = (norm > 0.0f) ? (sum_lo / norm) - EPS : 0.0f;
+    hi = (norm > 0.0f) ? (sum_hi / norm) + EPS : 0.0f;
+}
+
+float terrain_noise(int gx, int gz)
 {
     constexpr uint32_t SEED = 1337u;
     const float scale = 0.075f;
 
-    const float n = fbm_2d(gx * scale, gz * scale, SEED, 4, 2.0f, 0.5f);
-    const int h = 10 + static_cast<int>(std::floor(n * 7.0f));
-    return std::clamp(h, 10, 16);
+    return fbm_2d(gx * scale, gz * scale, SEED, 4, 2.0f, 0.5f);
+}
+
+int terrain_height_from_noise(float n, int min_height, int max_height)
+{
+    const int h = min_height + static_cast<int>(std::floor(n * static_cast<float>(max_height - min_height + 1)));
+    return std::clamp(h, min_height, max_height);
+}
+
+int terrain_height(int gx, int gz, int min_height, int max_height)
+{
+    return terrain_height_from_noise(terrain_noise(gx, gz), min_height, max_height);
+}
+
+int terrain_height_10_16(int gx, int gz)
+{
+    return terrain_height(gx, gz, 10, 16);
+}
+
+static constexpr uint32_t CAVE_SEED = 7331u;
+static constexpr float CAVE_SCALE = 0.06f;
+static constexpr int CAVE_OCTAVES = 3;
+
+float cave_noise(int gx, int gy, int gz)
+{
+    return fbm_3d(gx * CAVE_SCALE, gy * CAVE_SCALE, gz * CAVE_SCALE, CAVE_SEED, CAVE_OCTAVES, 2.0f, 0.5f);
+}
+
+void cave_noise_bounds(int gx0, int gy0, int gz0, int gx1, int gy1, int gz1, float& lo, float& hi)
+{
+    fbm_3d_bounds(gx0 * CAVE_SCALE, gy0 * CAVE_SCALE, gz0 * CAVE_SCALE,
+        gx1 * CAVE_SCALE, gy1 * CAVE_SCALE, gz1 * CAVE_SCALE,
+        CAVE_SEED, CAVE_OCTAVES, 2.0f, 0.5f, lo, hi);
 }
@@ -0,0 +1,246 @@
+#include "world/PackedChunk.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <mutex>
+
+namespace {
+
+constexpr int ROW = 16;
+constexpr int ROWS = CHUNK_VOLUME / ROW;
+
+std::mutex g_cache_mutex;
+std::vector<const PackedChunk*> g_cache;    // entries whose `cached` is set
+size_t g_capacity = 64;
+PackedCacheStats g_stats;
+
+// Recency clock: bumped per miss, stamped into last_use on every hit
+std::atomic<uint64_t> g_tick{ 1 };
+
+void destroy_packed(const void* p)
+{
+    delete static_cast<const PackedChunk*>(p);
+}
+
+// Unpacked views held by the cache count as cache memory, not chunk blocks.
+// A view leaving the cache moves back, so its destructor balances ChunkBlocks.
+void charge_to_cache(const ChunkVersion* v)
+{
+    mem_track_free(MemCategory::ChunkBlocks, sizeof(v->blocks));
+    mem_track_alloc(MemCategory::Caches, sizeof(v->blocks));
+}
+
+void uncharge_from_cache(const ChunkVersion* v)
+{
+    mem_track_free(MemCategory::Caches, sizeof(v->blocks));
+    mem_track_alloc(MemCategory::ChunkBlocks, sizeof(v->blocks));
+}
+
+void evict_one_locked()
+{
+    auto oldest = std::min_element(g_cache.begin(), g_cache.end(), [](const PackedChunk* a, const PackedChunk* b) {
+        return a->last_use.load(std::memory_order_relaxed) < b->last_use.load(std::memory_order_relaxed);
+    });
+
+    const PackedChunk* p = *oldest;
+    *oldest = g_cache.back();
+    g_cache.pop_back();
+
+    // Readers that already loaded the version keep it until their epoch ends
+    const ChunkVersion* v = p->cached.exchange(nullptr, std::memory_order_acq_rel);
+    uncharge_from_cache(v);
+    chunk_version_release(v);
+    ++g_stats.evictions;
+}
+
+} // namespace
+
+PackedChunk::PackedChunk(std::vector<uint8_t> palette_in, std::vector<uint8_t> codes_in)
+    : palette(std::move(palette_in)), codes(std::move(codes_in))
+{
+    mem_track_alloc(MemCategory::ChunkPacked, bytes());
+}
+
+PackedChunk::~PackedChunk()
+{
+    mem_track_free(MemCategory::ChunkPacked, bytes());
+}
+
+bool pack_block_codes(const uint8_t* data, std::vector<uint8_t>& palette, std::vector<uint8_t>& codes)
+{
+    std::array<uint8_t, 256> slot_of;
+    slot_of.fill(0xFF);
+    palette.clear();
+    codes.clear();
+
+    for (int i = 0; i < CHUNK_VOLUME; ++i) {
+        const uint8_t b = data[i];
+        if (slot_of[b] != 0xFF) continue;
+        if (palette.size() == PackedChunk::PACKED_MAX_PALETTE) return false;
+        slot_of[b] = static_cast<uint8_t>(palette.size());
+        palette.push_back(b);
+    }
+
+    codes.reserve(512);
+
+    int row = 0;
+    while (row < ROWS) {
+        const uint8_t* cur = data + row * ROW;
+
+        // Rows identical to the one before collapse into repeat codes
+        if (row > 0 && std::memcmp(cur, cur - ROW, ROW) == 0) {
+            int n = 1;
+            while (row + n < ROWS && n < ROW && std::memcmp(cur + n * ROW, cur - ROW, ROW) == 0) ++n;
+            codes.push_back(static_cast<uint8_t>((PackedChunk::PACKED_REPEAT << 4) | (n - 1)));
+            row += n;
+            continue;
+        }
+
+        int x = 0;
+        while (x < ROW) {
+            int len = 1;
+            while (x + len < ROW && cur[x + len] == cur[x]) ++len;
+            codes.push_back(static_cast<uint8_t>((slot_of[cur[x]] << 4) | (len - 1)));
+            x += len;
+        }
+        ++row;
+    }
+    return true;
+}
+
+bool unpack_block_codes(const uint8_t* palette, size_t palette_size, const uint8_t* codes, size_t code_count, uint8_t* out)
+{
+    size_t pos = 0;
+
+    for (size_t i = 0; i < code_count; ++i) {
+        const uint8_t idx = codes[i] >> 4;
+        const size_t len = static_cast<size_t>(codes[i] & 15) + 1;
+
+        if (idx == PackedChunk::PACKED_REPEAT) {
+            if (pos < ROW || pos % ROW != 0 || pos + len * ROW > CHUNK_VOLUME) return false;
+            for (size_t r = 0; r < len; ++r, pos += ROW) {
+                std::memcpy(out + pos, out + pos - ROW, ROW);
+            }
+        }
+        else {
+            // Runs never cross a row or run past the section
+            if (idx >= palette_size || pos + len > CHUNK_VOLUME || pos % ROW + len > ROW) return false;
+            std::memset(out + pos, palette[idx], len);
+            pos += len;
+        }
+    }
+    return pos == CHUNK_VOLUME;
+}
+
+const PackedChunk* pack_chunk(const Chunk& c)
+{
+    std::vector<uint8_t> palette;
+    std::vector<uint8_t> codes;
+    if (!pack_block_codes(c.blocks.data(), palette, codes)) return nullptr;
+
+    codes.shrink_to_fit();
+    return new PackedChunk(std::move(palette), std::move(codes));
+}
+
+void unpack_chunk(const PackedChunk& p, Chunk& out)
+{
+    uint8_t* dst = out.blocks.data();
+    size_t pos = 0;
+
+    for (const uint8_t code : p.codes) {
+        const uint8_t idx = code >> 4;
+        const size_t len = static_cast<size_t>(code & 15) + 1;
+
+        if (idx == PackedChunk::PACKED_REPEAT) {
+            for (size_t i = 0; i < len; ++i, pos += ROW) {
+                std::memcpy(dst + pos, dst + pos - ROW, ROW);
+            }
+        }
+        else {
+            std::memset(dst + pos, p.palette[idx], len);
+            pos += len;
+        }
+    }
+}
+
+void packed_chunk_acquire(const PackedChunk* p)
+{
+    if (p) p->refs.fetch_add(1, std::memory_order_relaxed);
+}
+
+void packed_chunk_release(const PackedChunk* p)
+{
+    if (!p || p->refs.fetch_sub(1, std::memory_order_acq_rel) != 1) return;
+
+    {
+        // A reader still holding `p` must not re-insert it after this
+        std::lock_guard<std::mutex> lock(g_cache_mutex);
+        p->dead = true;
+        if (const ChunkVersion* v = p->cached.exchange(nullptr, std::memory_order_acq_rel)) {
+            g_cache.erase(std::find(g_cache.begin(), g_cache.end(), p));
+            uncharge_from_cache(v);
+            chunk_version_release(v);
+        }
+    }
+    chunk_retire(p, &destroy_packed);
+}
+
+const ChunkVersion* packed_chunk_view(const PackedChunk* p)
+{
+    if (const ChunkVersion* v = p->cached.load(std::memory_order_acquire)) {
+        // Only write on change: hot loops re-reading one section stay read-only
+        const uint64_t now = g_tick.load(std::memory_order_relaxed);
+        if (p->last_use.load(std::memory_order_relaxed) != now) {
+            p->last_use.store(now, std::memory_order_relaxed);
+        }
+        return v;
+    }
+
+    std::lock_guard<std::mutex> lock(g_cache_mutex);
+    if (const ChunkVersion* v = p->cached.load(std::memory_order_acquire)) return v;
+
+    const auto t0 = std::chrono::steady_clock::now();
+    ChunkVersion* v = new ChunkVersion();
+    unpack_chunk(*p, *v);
+    const double us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - t0).count();
+
+    ++g_stats.misses;
+    g_stats.max_unpack_us = std::max(g_stats.max_unpack_us, us);
+
+    if (p->dead || g_capacity == 0) {
+        // Uncached: retire right away, the epoch keeps it alive for this reader
+        chunk_version_release(v);
+        return v;
+    }
+
+    while (g_cache.size() >= g_capacity) evict_one_locked();
+
+    p->last_use.store(g_tick.fetch_add(1, std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    charge_to_cache(v);
+    p->cached.store(v, std::memory_order_release);
+    g_cache.push_back(p);
+    return v;
+}
+
+void packed_cache_set_capacity(size_t sections)
+{
+    std::lock_guard<std::mutex> lock(g_cache_mutex);
+    g_capacity = sections;
+    while (g_cache.size() > g_capacity) evict_one_locked();
+}
+
+PackedCacheStats packed_cache_stats()
+{
+    std::lock_guard<std::mutex> lock(g_cache_mutex);
+    PackedCacheStats s = g_stats;
+    s.resident = g_cache.size();
+    s.capacity = g_capacity;
+    return s;
+}
+
+void packed_cache_clear()
+{
+    std::lock_guard<std::mutex> lock(g_cache_mutex);
+    while (!g_cache.empty()) evict_one_locked();
+}
@@ -0,0 +1,424 @@
+#include "world/TickScheduler.h"
+#include "world/BlockRegistry.h"
+
+#include <algorithm>
+#include <chrono>
+
+namespace {
+
+constexpr int PHASES = 8;
+
+uint32_t pack_pos(int gx, int gy, int gz)
+{
+    return static_cast<uint32_t>(gx + WORLD_SIZE_X * (gz + WORLD_SIZE_Z * gy));
+}
+
+void unpack_pos(uint32_t p, int& gx, int& gy, int& gz)
+{
+    gx = static_cast<int>(p % WORLD_SIZE_X);
+    p /= WORLD_SIZE_X;
+    gz = static_cast<int>(p % WORLD_SIZE_Z);
+    gy = static_cast<int>(p / WORLD_SIZE_Z);
+}
+
+uint16_t local_index(int lx, int ly, int lz)
+{
+    return static_cast<uint16_t>(lx + CHUNK_X * (ly + CHUNK_Y * lz));
+}
+
+int section_phase(const SectionCoord& c)
+{
+    return (c.cx & 1) | ((c.cy & 1) << 1) | ((c.cz & 1) << 2);
+}
+
+struct CrossWrite
+{
+    int gx, gy, gz;
+    BlockType t;
+};
+
+struct Wake
+{
+    int gx, gy, gz;
+    uint32_t delay;
+};
+
+} // namespace
+
+struct TickScheduler::Task
+{
+    SectionCoord at;
+    std::vector<uint16_t> positions;
+
+    ChunkVersion* edit = nullptr;       // private copy, created on the first write
+    uint8_t borders = 0;                // bit per face written: -x +x -y +y -z +z
+    uint32_t changed = 0;
+    std::vector<CrossWrite> cross;
+    std::vector<Wake> wakes;
+};
+
+class TickScheduler::Context
+{
+public:
+    Context(const World& world, Task& task, uint64_t tick)
+        : m_world(world), m_task(task), m_section(world.section_at(task.at.cx, task.at.cy, task.at.cz)), m_tick(tick),
+          m_x0(task.at.cx * CHUNK_X), m_y0(task.at.cy * CHUNK_Y), m_z0(task.at.cz * CHUNK_Z)
+    {
+    }
+
+    BlockType get(int gx, int gy, int gz) const
+    {
+        const int lx = gx - m_x0;
+        const int ly = gy - m_y0;
+        const int lz = gz - m_z0;
+        if (!own(lx, ly, lz)) return m_world.get_global(gx, gy, gz);
+        return m_task.edit ? m_task.edit->get_local(lx, ly, lz) : m_section.get_local(lx, ly, lz);
+    }
+
+    void set(int gx, int gy, int gz, BlockType t)
+    {
+        if (gx < 0 || gx >= WORLD_SIZE_X || gy < 0 || gy >= m_world.size_y() || gz < 0 || gz >= WORLD_SIZE_Z) return;
+
+        const int lx = gx - m_x0;
+        const int ly = gy - m_y0;
+        const int lz = gz - m_z0;
+        if (own(lx, ly, lz)) {
+            if (!m_task.edit) m_task.edit = m_world.begin_section_edit(m_task.at.cx, m_task.at.cy, m_task.at.cz);
+            m_task.edit->set_local(lx, ly, lz, t);
+            m_task.borders |= (lx == 0 ? 1 : 0) | (lx == CHUNK_X - 1 ? 2 : 0) |
+                (ly == 0 ? 4 : 0) | (ly == CHUNK_Y - 1 ? 8 : 0) |
+                (lz == 0 ? 16 : 0) | (lz == CHUNK_Z - 1 ? 32 : 0);
+        }
+        else {
+            m_task.cross.push_back(CrossWrite{ gx, gy, gz, t });
+        }
+        ++m_task.changed;
+
+        // Block update: the changed block and its six neighbors tick next
+        schedule(gx, gy, gz, 0);
+        schedule(gx + 1, gy, gz, 0);
+        schedule(gx - 1, gy, gz, 0);
+        schedule(gx, gy + 1, gz, 0);
+        schedule(gx, gy - 1, gz, 0);
+        schedule(gx, gy, gz + 1, 0);
+        schedule(gx, gy, gz - 1, 0);
+    }
+
+    void schedule(int gx, int gy, int gz, uint32_t delay)
+    {
+        m_task.wakes.push_back(Wake{ gx, gy, gz, delay });
+    }
+
+    // Deterministic per block and tick, independent of thread timing.
+    uint32_t random(int gx, int gy, int gz) const
+    {
+        uint64_t h = pack_pos(gx, gy, gz) * 0x9E3779B97F4A7C15ull ^ (m_tick + 0x632BE59BD9B4E019ull) * 0xC2B2AE3D27D4EB4Full;
+        h ^= h >> 29;
+        h *= 0xBF58476D1CE4E5B9ull;
+        h ^= h >> 32;
+        return static_cast<uint32_t>(h);
+    }
+
+private:
+    static bool own(int lx, int ly, int lz)
+    {
+        return static_cast<unsigned>(lx) < CHUNK_X && static_cast<unsigned>(ly) < CHUNK_Y && static_cast<unsigned>(lz) < CHUNK_Z;
+    }
+
+    const World& m_world;
+    Task& m_task;
+    const ChunkSection& m_section;
+    uint64_t m_tick;
+    int m_x0, m_y0, m_z0;
+};
+
+namespace {
+
+using TickRule = void (*)(TickScheduler::Context&, int, int, int);
+
+// Grass under an opaque block dies back to stone. Uncovered grass spreads to
+// uncovered stone among its 26 neighbors: now and then when woken, and on a
+// timer while candidates are left.
+void tick_grass(TickScheduler::Context& c, int x, int y, int z)
+{
+    if (block_opaque(c.get(x, y + 1, z))) {
+        c.set(x, y, z, BlockType::Stone);
+        return;
+    }
+
+    std::array<std::array<int, 3>, 26> candidates;
+    int n = 0;
+    for (int dy = -1; dy <= 1; ++dy) {
+        for (int dz = -1; dz <= 1; ++dz) {
+            for (int dx = -1; dx <= 1; ++dx) {
+                if (c.get(x + dx, y + dy, z + dz) == BlockType::Stone &&
+                    !block_opaque(c.get(x + dx, y + dy + 1, z + dz))) {
+                    candidates[n++] = { x + dx, y + dy, z + dz };
+                }
+            }
+        }
+    }
+    if (n == 0) return;     // idle until an edit nearby wakes it
+
+    const uint32_t r = c.random(x, y, z);
+    if ((r & 3) == 0) {
+        const auto& p = candidates[(r >> 2) % static_cast<uint32_t>(n)];
+        c.set(p[0], p[1], p[2], BlockType::Grass);
+    }
+    c.schedule(x, y, z, 40 + (r >> 16) % 80);
+}
+
+// Sand falls one block per tick while the block below is not solid, trading
+// places with it (air, water).
+void tick_sand(TickScheduler::Context& c, int x, int y, int z)
+{
+    if (y == 0) return;
+    const BlockType below = c.get(x, y - 1, z);
+    if (!block_solid(below)) {
+        c.set(x, y - 1, z, BlockType::Sand);
+        c.set(x, y, z, below);
+    }
+}
+
+TickRule rule_for(BlockType t)
+{
+    switch (t) {
+    case BlockType::Grass: return &tick_grass;
+    case BlockType::Sand:  return &tick_sand;
+    default:               return nullptr;
+    }
+}
+
+} // namespace
+
+bool block_ticks(BlockType t)
+{
+    return rule_for(t) != nullptr;
+}
+
+TickScheduler::TickScheduler(World& world, JobPool& pool)
+    : m_world(world), m_pool(pool),
+      m_sections(static_cast<size_t>(WORLD_CHUNKS_X) * WORLD_CHUNKS_Z * static_cast<size_t>(world.chunks_y()))
+{
+}
+
+TickScheduler::~TickScheduler() = default;
+
+uint32_t TickScheduler::section_index(int cx, int cy, int cz) const
+{
+    return static_cast<uint32_t>(World::col_idx(cx, cz) * m_world.chunks_y() + cy);
+}
+
+void TickScheduler::schedule(int gx, int gy, int gz, uint32_t delay)
+{
+    if (gx < 0 || gx >= WORLD_SIZE_X || gy < 0 || gy >= m_world.size_y() || gz < 0 || gz >= WORLD_SIZE_Z) return;
+
+    if (delay == 0) {
+        activate(gx, gy, gz);
+        return;
+    }
+
+    // Delays past one wheel turn stay in their slot until their round comes
+    const uint64_t due = m_tick + delay;
+    m_wheel[due % WHEEL_SLOTS].push_back(Timer{ pack_pos(gx, gy, gz), due });
+    ++m_delayed;
+}
+
+void TickScheduler::activate(int gx, int gy, int gz)
+{
+    const int cx = gx / CHUNK_X;
+    const int cy = gy / CHUNK_Y;
+    const int cz = gz / CHUNK_Z;
+    const uint32_t si = section_index(cx, cy, cz);
+
+    std::unique_ptr<SectionTicks>& st = m_sections[si];
+    if (!st) st = std::make_unique<SectionTicks>();
+
+    const uint16_t li = local_index(gx % CHUNK_X, gy % CHUNK_Y, gz % CHUNK_Z);
+    uint64_t& word = st->queued[li >> 6];
+    const uint64_t bit = 1ull << (li & 63);
+    if (word & bit) return;
+
+    word |= bit;
+    st->active.push_back(li);
+    if (!st->listed) {
+        st->listed = true;
+        m_active_sections.push_back(si);
+    }
+}
+
+void TickScheduler::wake_box(const BlockBox& box)
+{
+    const int x0 = std::max(box.x0, 0), x1 = std::min(box.x1, WORLD_SIZE_X);
+    const int y0 = std::max(box.y0, 0), y1 = std::min(box.y1, m_world.size_y());
+    const int z0 = std::max(box.z0, 0), z1 = std::min(box.z1, WORLD_SIZE_Z);
+
+    for (int gz = z0; gz < z1; ++gz) {
+        for (int gy = y0; gy < y1; ++gy) {
+            for (int gx = x0; gx < x1; ++gx) {
+                if (block_ticks(m_world.get_global(gx, gy, gz))) activate(gx, gy, gz);
+            }
+        }
+    }
+}
+
+void TickScheduler::wake_sections(const std::vector<SectionCoord>& sections)
+{
+    for (const SectionCoord& c : sections) {
+        const ChunkSection& sec = m_world.section_at(c.cx, c.cy, c.cz);
+        if (sec.is_uniform() && !block_ticks(sec.fill())) continue;
+
+        for (int lz = 0; lz < CHUNK_Z; ++lz) {
+            for (int ly = 0; ly < CHUNK_Y; ++ly) {
+                for (int lx = 0; lx < CHUNK_X; ++lx) {
+                    if (block_ticks(sec.get_local(lx, ly, lz))) {
+                        activate(c.cx * CHUNK_X + lx, c.cy * CHUNK_Y + ly, c.cz * CHUNK_Z + lz);
+                    }
+                }
+            }
+        }
+    }
+}
+
+size_t TickScheduler::active_blocks() const
+{
+    size_t n = 0;
+    for (const uint32_t si : m_active_sections) n += m_sections[si]->active.size();
+    return n;
+}
+
+size_t TickScheduler::delayed_blocks() const
+{
+    return m_delayed;
+}
+
+void TickScheduler::run_task(Task& task)
+{
+    ChunkReadGuard guard;
+    Context ctx(m_world, task, m_tick);
+
+    const int x0 = task.at.cx * CHUNK_X;
+    const int y0 = task.at.cy * CHUNK_Y;
+    const int z0 = task.at.cz * CHUNK_Z;
+
+    for (const uint16_t li : task.positions) {
+        const int x = x0 + (li & 15);
+        const int y = y0 + ((li >> 4) & 15);
+        const int z = z0 + (li >> 8);
+        if (const TickRule rule = rule_for(ctx.get(x, y, z))) rule(ctx, x, y, z);
+    }
+}
+
+void TickScheduler::apply_phase(std::vector<Task>& tasks)
+{
+    const auto mark_dirty = [this](int cx, int cy, int cz, uint8_t borders) {
+        m_world.mark_section_dirty(cx, cy, cz);
+        if (borders & 1)  m_world.mark_section_dirty(cx - 1, cy, cz);
+        if (borders & 2)  m_world.mark_section_dirty(cx + 1, cy, cz);
+        if (borders & 4)  m_world.mark_section_dirty(cx, cy - 1, cz);
+        if (borders & 8)  m_world.mark_section_dirty(cx, cy + 1, cz);
+        if (borders & 16) m_world.mark_section_dirty(cx, cy, cz - 1);
+        if (borders & 32) m_world.mark_section_dirty(cx, cy, cz + 1);
+    };
+
+    std::vector<CrossWrite> cross;
+    for (Task& t : tasks) {
+        if (t.edit) {
+            m_world.commit_section_edit(t.at.cx, t.at.cy, t.at.cz, t.edit, true);
+            mark_dirty(t.at.cx, t.at.cy, t.at.cz, t.borders);
+            m_world.update_top_section(t.at.cx, t.at.cz);
+        }
+        cross.insert(cross.end(), t.cross.begin(), t.cross.end());
+        m_stats.blocks_changed += t.changed;
+    }
+
+    // Neighbor writes, one edit per target section; stable sort keeps task order per block
+    std::stable_sort(cross.begin(), cross.end(), [this](const CrossWrite& a, const CrossWrite& b) {
+        return section_index(a.gx / CHUNK_X, a.gy / CHUNK_Y, a.gz / CHUNK_Z) < section_index(b.gx / CHUNK_X, b.gy / CHUNK_Y, b.gz / CHUNK_Z);
+    });
+    m_stats.cross_writes += static_cast<uint32_t>(cross.size());
+
+    for (size_t i = 0; i < cross.size();) {
+        const int cx = cross[i].gx / CHUNK_X;
+        const int cy = cross[i].gy / CHUNK_Y;
+        const int cz = cross[i].gz / CHUNK_Z;
+        ChunkVersion* edit = m_world.begin_section_edit(cx, cy, cz);
+
+        uint8_t borders = 0;
+        for (; i < cross.size() && cross[i].gx / CHUNK_X == cx && cross[i].gy / CHUNK_Y == cy && cross[i].gz / CHUNK_Z == cz; ++i) {
+            const int lx = cross[i].gx % CHUNK_X;
+            const int ly = cross[i].gy % CHUNK_Y;
+            const int lz = cross[i].gz % CHUNK_Z;
+            edit->set_local(lx, ly, lz, cross[i].t);
+            borders |= (lx == 0 ? 1 : 0) | (lx == CHUNK_X - 1 ? 2 : 0) |
+                (ly == 0 ? 4 : 0) | (ly == CHUNK_Y - 1 ? 8 : 0) |
+                (lz == 0 ? 16 : 0) | (lz == CHUNK_Z - 1 ? 32 : 0);
+        }
+
+        m_world.commit_section_edit(cx, cy, cz, edit, true);
+        mark_dirty(cx, cy, cz, borders);
+        m_world.update_top_section(cx, cz);
+    }
+
+    for (const Task& t : tasks) {
+        for (const Wake& w : t.wakes) schedule(w.gx, w.gy, w.gz, w.delay);
+    }
+}
+
+void TickScheduler::tick()
+{
+    const auto t0 = std::chrono::steady_clock::now();
+    ++m_tick;
+
+    m_stats.blocks_ticked = 0;
+    m_stats.blocks_changed = 0;
+    m_stats.sections_ticked = 0;
+    m_stats.cross_writes = 0;
+
+    // Timers due now join the active set
+    std::vector<Timer>& slot = m_wheel[m_tick % WHEEL_SLOTS];
+    size_t keep = 0;
+    for (const Timer& t : slot) {
+        if (t.due <= m_tick) {
+            int gx = 0, gy = 0, gz = 0;
+            unpack_pos(t.pos, gx, gy, gz);
+            activate(gx, gy, gz);
+            --m_delayed;
+        }
+        else {
+            slot[keep++] = t;
+        }
+    }
+    slot.resize(keep);
+
+    // Take this tick's work; anything scheduled from here on runs next tick
+    std::array<std::vector<Task>, PHASES> phases;
+    std::sort(m_active_sections.begin(), m_active_sections.end());
+    for (const uint32_t si : m_active_sections) {
+        SectionTicks& st = *m_sections[si];
+
+        Task task;
+        task.at.cy = static_cast<int>(si % static_cast<uint32_t>(m_world.chunks_y()));
+        const int col = static_cast<int>(si / static_cast<uint32_t>(m_world.chunks_y()));
+        task.at.cx = col % WORLD_CHUNKS_X;
+        task.at.cz = col / WORLD_CHUNKS_X;
+        task.positions.swap(st.active);
+        std::sort(task.positions.begin(), task.positions.end());
+
+        st.queued.fill(0);
+        st.listed = false;
+        m_stats.blocks_ticked += static_cast<uint32_t>(task.positions.size());
+        phases[section_phase(task.at)].push_back(std::move(task));
+    }
+    m_stats.sections_ticked = static_cast<uint32_t>(m_active_sections.size());
+    m_active_sections.clear();
+
+    for (std::vector<Task>& tasks : phases) {
+        if (tasks.empty()) continue;
+        m_pool.parallel_for(static_cast<int>(tasks.size()), [&](int i) { run_task(tasks[static_cast<size_t>(i)]); });
+        apply_phase(tasks);
+    }
+
+    ++m_stats.ticks;
+    m_stats.ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+}
@@ -1,28 +1,655 @@
 #include "world/World.h"
+#include "world/BlockRegistry.h"
 #include "world/Noise.h"
 
-void World::fill_terrain_noise_10_16_grass_stone()
+#include <algorithm>
+
+ChunkSection::ChunkSection(ChunkSection&& o) noexcept
+    : dirty(o.dirty), touched(o.touched)
+{
+    m_chunk.store(o.m_chunk.exchange(nullptr));
+    m_packed.store(o.m_packed.exchange(nullptr));
+    m_fill.store(o.m_fill.load());
+}
+
+ChunkSection::~ChunkSection()
+{
+    chunk_version_release(m_chunk.exchange(nullptr));
+    packed_chunk_release(m_packed.exchange(nullptr));
+}
+
+void ChunkSection::publish(const ChunkVersion* v)
+{
+    // New storage goes in before the old tier is cleared, so readers never
+    // see both pointers null (see chunk())
+    chunk_version_release(m_chunk.exchange(v, std::memory_order_acq_rel));
+    packed_chunk_release(m_packed.exchange(nullptr, std::memory_order_acq_rel));
+}
+
+void ChunkSection::publish_packed(const PackedChunk* p)
+{
+    packed_chunk_release(m_packed.exchange(p, std::memory_order_acq_rel));
+    chunk_version_release(m_chunk.exchange(nullptr, std::memory_order_acq_rel));
+}
+
+void ChunkSection::publish_uniform(BlockType t)
+{
+    // fill first: a reader that sees the null chunk also sees the new fill
+    m_fill.store(t, std::memory_order_release);
+    chunk_version_release(m_chunk.exchange(nullptr, std::memory_order_acq_rel));
+    packed_chunk_release(m_packed.exchange(nullptr, std::memory_order_acq_rel));
+}
+
+WorldSnapshot::WorldSnapshot(const WorldSnapshot& o)
+    : m_chunks_y(o.m_chunks_y), m_sections(o.m_sections)
+{
+    for (const Entry& e : m_sections) {
+        chunk_version_acquire(e.chunk);
+        packed_chunk_acquire(e.packed);
+    }
+}
+
+WorldSnapshot& WorldSnapshot::operator=(const WorldSnapshot& o)
+{
+    if (this != &o) {
+        WorldSnapshot copy(o);
+        *this = std::move(copy);
+    }
+    return *this;
+}
+
+WorldSnapshot& WorldSnapshot::operator=(WorldSnapshot&& o) noexcept
+{
+    if (this != &o) {
+        release_all();
+        m_chunks_y = o.m_chunks_y;
+        m_sections = std::move(o.m_sections);
+        o.m_sections.clear();
+    }
+    return *this;
+}
+
+WorldSnapshot::~WorldSnapshot()
+{
+    release_all();
+}
+
+void WorldSnapshot::release_all()
+{
+    for (const Entry& e : m_sections) {
+        chunk_version_release(e.chunk);
+        packed_chunk_release(e.packed);
+    }
+    m_sections.clear();
+}
+
+World::World(int chunks_y)
+    : m_chunks_y(std::clamp(chunks_y, 1, MAX_WORLD_CHUNKS_Y))
+{
+    for (ChunkColumn& col : columns) {
+        col.sections.resize(static_cast<size_t>(m_chunks_y));
+    }
+}
+
+World::~World()
+{
+    for (ChunkColumn& col : columns) {
+        col.sections.clear();
+    }
+    chunk_versions_collect();
+}
+
+using ColumnHeights = std::array<int, CHUNK_X * CHUNK_Z>;
+
+// Largest power of two <= stride, within [1, 16] so lattices align with sections.
+static int normalize_noise_stride(int stride)
+{
+    int s = 1;
+    while (s * 2 <= stride && s * 2 <= CHUNK_X) s *= 2;
+    return s;
+}
+
+// Surface height of every block column in chunk column (cx, cz), clamped to
+// the world, plus the lowest and highest of them. With stride > 1 the noise is
+// sampled every `stride` blocks and bilinearly interpolated before quantizing.
+static void column_heights(int cx, int cz, int min_height, int max_height, int size_y, int stride,
+    ColumnHeights& heights, int& col_min, int& col_max, uint64_t& samples)
+{
+    const int gx0 = cx * CHUNK_X;
+    const int gz0 = cz * CHUNK_Z;
+
+    constexpr int MAX_NODES = CHUNK_X / 2 + 1;
+    std::array<float, MAX_NODES * MAX_NODES> nodes{};
+    const int n = CHUNK_X / stride + 1;
+    if (stride > 1) {
+        for (int k = 0; k < n; ++k) {
+            for (int i = 0; i < n; ++i) {
+                nodes[i + n * k] = terrain_noise(gx0 + i * stride, gz0 + k * stride);
+            }
+        }
+        samples += static_cast<uint64_t>(n * n);
+    }
+    else {
+        samples += CHUNK_X * CHUNK_Z;
+    }
+
+    const float inv = 1.0f / static_cast<float>(stride);
+
+    col_min = size_y;
+    col_max = 0;
+    for (int lz = 0; lz < CHUNK_Z; ++lz) {
+        for (int lx = 0; lx < CHUNK_X; ++lx) {
+            float noise = 0.0f;
+            if (stride > 1) {
+                const int i = lx / stride;
+                const int k = lz / stride;
+                const float fx = static_cast<float>(lx % stride) * inv;
+                const float fz = static_cast<float>(lz % stride) * inv;
+                const float a = nodes[i + n * k] + (nodes[i + 1 + n * k] - nodes[i + n * k]) * fx;
+                const float b = nodes[i + n * (k + 1)] + (nodes[i + 1 + n * (k + 1)] - nodes[i + n * (k + 1)]) * fx;
+                noise = a + (b - a) * fz;
+            }
+            else {
+                noise = terrain_noise(gx0 + lx, gz0 + lz);
+            }
+
+            const int h = std::min(terrain_height_from_noise(noise, min_height, max_height), size_y);
+            heights[lx + CHUNK_X * lz] = h;
+            col_min = std::min(col_min, h);
+            col_max = std::max(col_max, h);
+        }
+    }
+}
+
+// Cave noise for one section: sampled per voxel at stride 1, otherwise on a
+// stride-aligned lattice (sampled lazily, only where a brick needs it) and
+// trilinearly interpolated.
+class CaveLattice
 {
-    for (int gz = 0; gz < WORLD_SIZE_Z; ++gz) {
-        for (int gx = 0; gx < WORLD_SIZE_X; ++gx) {
-            const int h = terrain_height_10_16(gx, gz);
+public:
+    explicit CaveLattice(int stride)
+        : m_stride(stride), m_n(CHUNK_X / stride + 1)
+    {
+        if (m_stride > 1) m_nodes.resize(static_cast<size_t>(m_n * m_n * m_n));
+    }
+
+    void reset(int gx0, int gy0, int gz0)
+    {
+        m_gx0 = gx0;
+        m_gy0 = gy0;
+        m_gz0 = gz0;
+        std::fill(m_nodes.begin(), m_nodes.end(), UNSAMPLED);
+    }
+
+    int stride() const { return m_stride; }
+
+    // Local block range [l0, l1] whose noise feeds voxels in [b0, b0 + size).
+    void support(int b0, int size, int& l0, int& l1) const
+    {
+        if (m_stride == 1) {
+            l0 = b0;
+            l1 = b0 + size - 1;
+            return;
+        }
+        l0 = (b0 / m_stride) * m_stride;
+        l1 = ((b0 + size - 1) / m_stride) * m_stride + m_stride;
+    }
+
+    float at(int lx, int ly, int lz, uint64_t& samples)
+    {
+        if (m_stride == 1) {
+            ++samples;
+            return cave_noise(m_gx0 + lx, m_gy0 + ly, m_gz0 + lz);
+        }
+
+        const int i = lx / m_stride;
+        const int j = ly / m_stride;
+        const int k = lz / m_stride;
+        const float inv = 1.0f / static_cast<float>(m_stride);
+        const float fx = static_cast<float>(lx % m_stride) * inv;
+        const float fy = static_cast<float>(ly % m_stride) * inv;
+        const float fz = static_cast<float>(lz % m_stride) * inv;
+
+        const auto lerp = [](float a, float b, float t) { return a + (b - a) * t; };
+        const float a = lerp(lerp(node(i, j, k, samples), node(i + 1, j, k, samples), fx),
+            lerp(node(i, j + 1, k, samples), node(i + 1, j + 1, k, samples), fx), fy);
+        const float b = lerp(lerp(node(i, j, k + 1, samples), node(i + 1, j, k + 1, samples), fx),
+            lerp(node(i, j + 1, k + 1, samples), node(i + 1, j + 1, k + 1, samples), fx), fy);
+        return lerp(a, b, fz);
+    }
+
+private:
+    static constexpr float UNSAMPLED = -1.0f;
+
+    float node(int i, int j, int k, uint64_t& samples)
+    {
+        float& v = m_nodes[static_cast<size_t>(i + m_n * (j + m_n * k))];
+        if (v == UNSAMPLED) {
+            v = cave_noise(m_gx0 + i * m_stride, m_gy0 + j * m_stride, m_gz0 + k * m_stride);
+            ++samples;
+        }
+        return v;
+    }
+
+    int m_stride = 1;
+    int m_n = 0;
+    int m_gx0 = 0, m_gy0 = 0, m_gz0 = 0;
+    std::vector<float> m_nodes;
+};
+
+struct DensityTarget
+{
+    ChunkVersion& chunk;
+    const ColumnHeights& heights;
+    CaveLattice& cave;
+    int gx0, y0, gz0;   // section origin in blocks
+};
+
+// Smallest cube the cave bounds are refined down to before sampling per voxel.
+static constexpr int DENSITY_BRICK = 4;
+
+// Cave noise range over the lattice support of local cube [b, b + size). An
+// interpolated value is a blend of lattice samples, so it stays inside too.
+static void cave_block_bounds(const CaveLattice& cave, int gx0, int gy0, int gz0,
+    int bx, int by, int bz, int size, float& lo, float& hi)
+{
+    int x0 = 0, x1 = 0, y0 = 0, y1 = 0, z0 = 0, z1 = 0;
+    cave.support(bx, size, x0, x1);
+    cave.support(by, size, y0, y1);
+    cave.support(bz, size, z0, z1);
+    cave_noise_bounds(gx0 + x0, gy0 + y0, gz0 + z0, gx0 + x1, gy0 + y1, gz0 + z1, lo, hi);
+}
+
+// Fills the cube of `size` at local (bx, by, bz). With may_carve, its cave
+// noise range is bounded first: cubes entirely past the threshold stay air,
+// cubes entirely below it get the plain heightmap fill, and the rest split
+// into octants down to DENSITY_BRICK, where each voxel is sampled.
+static void fill_density_block(const DensityTarget& t, int bx, int by, int bz, int size, bool may_carve, TerrainGenStats& stats)
+{
+    int top_max = 0;
+    for (int lz = bz; lz < bz + size; ++lz) {
+        for (int lx = bx; lx < bx + size; ++lx) {
+            top_max = std::max(top_max, t.heights[lx + CHUNK_X * lz]);
+        }
+    }
+
+    // Above the surface: air, nothing to evaluate
+    if (t.y0 + by >= top_max) {
+        ++stats.bricks_skipped;
+        return;
+    }
+
+    bool carve = false;
+    if (may_carve) {
+        float lo = 0.0f;
+        float hi = 0.0f;
+        cave_block_bounds(t.cave, t.gx0, t.y0, t.gz0, bx, by, bz, size, lo, hi);
+
+        if (lo > CAVE_THRESHOLD) {
+            ++stats.bricks_skipped;
+            return;
+        }
+
+        carve = hi > CAVE_THRESHOLD;
+        if (carve && size > DENSITY_BRICK) {
+            const int h = size / 2;
+            for (int oct = 0; oct < 8; ++oct) {
+                fill_density_block(t, bx + (oct & 1) * h, by + ((oct >> 1) & 1) * h, bz + (oct >> 2) * h, h, true, stats);
+            }
+            return;
+        }
+    }
+
+    if (carve) ++stats.bricks_sampled;
+    else ++stats.bricks_skipped;
+
+    for (int lz = bz; lz < bz + size; ++lz) {
+        for (int lx = bx; lx < bx + size; ++lx) {
+            const int h = t.heights[lx + CHUNK_X * lz];
+            const int top = std::min(h, t.y0 + by + size);
+
+            for (int gy = t.y0 + by; gy < top; ++gy) {
+                if (carve && t.cave.at(lx, gy - t.y0, lz, stats.noise_samples) > CAVE_THRESHOLD) continue;
+
+                const BlockType bt = (gy == h - 1) ? BlockType::Grass : BlockType::Stone;
+                t.chunk.set_local(lx, gy - t.y0, lz, bt);
+            }
+        }
+    }
+}
+
+void World::generate_column_noise(int cx, int cz, int min_height, int max_height, int noise_stride, TerrainGenStats& stats)
+{
+    const int stride = normalize_noise_stride(noise_stride);
+    ChunkColumn& col = column_at(cx, cz);
+
+    ColumnHeights heights{};
+    int col_min = 0;
+    int col_max = 0;
+    column_heights(cx, cz, min_height, max_height, size_y(), stride, heights, col_min, col_max, stats.height_samples);
+
+    // Below the lowest grass block everything is stone; above the highest
+    // column everything is air. Only the band in between is voxelized.
+    col.top_section = -1;
+    for (int cy = 0; cy < m_chunks_y; ++cy) {
+        ChunkSection& sec = col.sections[cy];
+
+        const int y0 = cy * CHUNK_Y;
+        const int y1 = y0 + CHUNK_Y;
+
+        if (y0 >= col_max) {
+            sec.publish_uniform(BlockType::Air);
+            ++stats.sections_uniform;
+            continue;
+        }
 
-            for (int gy = 0; gy < WORLD_SIZE_Y; ++gy) {
-                BlockType t = BlockType::Air;
-                if (gy < h) {
-                    t = (gy == h - 1) ? BlockType::Grass : BlockType::Stone;
+        col.top_section = cy;
+
+        if (y1 <= col_min - 1) {
+            sec.publish_uniform(BlockType::Stone);
+            ++stats.sections_uniform;
+            continue;
+        }
+
+        ChunkVersion* v = new ChunkVersion();
+
+        for (int lz = 0; lz < CHUNK_Z; ++lz) {
+            for (int lx = 0; lx < CHUNK_X; ++lx) {
+                const int h = heights[lx + CHUNK_X * lz];
+                const int top = std::min(h, y1);
+
+                for (int gy = y0; gy < top; ++gy) {
+                    const BlockType t = (gy == h - 1) ? BlockType::Grass : BlockType::Stone;
+                    v->set_local(lx, gy - y0, lz, t);
                 }
+            }
+        }
+
+        sec.publish(v);
+    }
+}
+
+void World::fill_terrain_noise_grass_stone(int min_height, int max_height, int noise_stride, TerrainGenStats* stats)
+{
+    TerrainGenStats local;
+
+    for (int cz = 0; cz < WORLD_CHUNKS_Z; ++cz) {
+        for (int cx = 0; cx < WORLD_CHUNKS_X; ++cx) {
+            generate_column_noise(cx, cz, min_height, max_height, noise_stride, local);
+        }
+    }
+
+    if (stats) *stats = local;
+}
+
+void World::fill_terrain_noise_10_16_grass_stone()
+{
+    fill_terrain_noise_grass_stone(10, 16);
+}
+
+void World::generate_column_caves(int cx, int cz, int min_height, int max_height, int noise_stride, TerrainGenStats& stats)
+{
+    const int stride = normalize_noise_stride(noise_stride);
+    ChunkColumn& col = column_at(cx, cz);
+    CaveLattice cave(stride);
+
+    ColumnHeights heights{};
+    int col_min = 0;
+    int col_max = 0;
+    column_heights(cx, cz, min_height, max_height, size_y(), stride, heights, col_min, col_max, stats.height_samples);
+
+    const int gx0 = cx * CHUNK_X;
+    const int gz0 = cz * CHUNK_Z;
+
+    for (int cy = 0; cy < m_chunks_y; ++cy) {
+        ChunkSection& sec = col.sections[cy];
+
+        const int y0 = cy * CHUNK_Y;
+        const int y1 = y0 + CHUNK_Y;
+
+        if (y0 >= col_max) {
+            sec.publish_uniform(BlockType::Air);
+            ++stats.sections_uniform;
+            continue;
+        }
+
+        float lo = 0.0f;
+        float hi = 0.0f;
+        cave_block_bounds(cave, gx0, y0, gz0, 0, 0, 0, CHUNK_X, lo, hi);
+
+        if (lo > CAVE_THRESHOLD) {
+            sec.publish_uniform(BlockType::Air);
+            ++stats.sections_uniform;
+            continue;
+        }
+
+        const bool cave_free = hi <= CAVE_THRESHOLD;
+        if (cave_free && y1 <= col_min - 1) {
+            sec.publish_uniform(BlockType::Stone);
+            ++stats.sections_uniform;
+            continue;
+        }
+
+        cave.reset(gx0, y0, gz0);
+
+        ChunkVersion* v = new ChunkVersion();
+        const DensityTarget target{ *v, heights, cave, gx0, y0, gz0 };
+        if (cave_free) {
+            fill_density_block(target, 0, 0, 0, CHUNK_X, false, stats);
+        }
+        else {
+            for (int oct = 0; oct < 8; ++oct) {
+                const int h = CHUNK_X / 2;
+                fill_density_block(target, (oct & 1) * h, ((oct >> 1) & 1) * h, (oct >> 2) * h, h, true, stats);
+            }
+        }
+
+        // Carving can leave a section all air (or all stone)
+        commit_section_edit(cx, cy, cz, v, true);
+    }
+
+    update_top_section(cx, cz);
+}
+
+void World::fill_terrain_caves_grass_stone(int min_height, int max_height, int noise_stride, TerrainGenStats* stats)
+{
+    TerrainGenStats local;
+
+    for (int cz = 0; cz < WORLD_CHUNKS_Z; ++cz) {
+        for (int cx = 0; cx < WORLD_CHUNKS_X; ++cx) {
+            generate_column_caves(cx, cz, min_height, max_height, noise_stride, local);
+        }
+    }
+
+    if (stats) *stats = local;
+}
+
+bool World::section_buried(int cx, int cy, int cz) const
+{
+    const auto opaque_uniform = [this](int x, int y, int z) {
+        if (x < 0 || x >= WORLD_CHUNKS_X ||
+            y < 0 || y >= m_chunks_y ||
+            z < 0 || z >= WORLD_CHUNKS_Z) {
+            return false;
+        }
+        const ChunkSection& s = section_at(x, y, z);
+        return s.is_uniform() && block_opaque(s.fill());
+    };
+
+    return opaque_uniform(cx, cy, cz) &&
+        opaque_uniform(cx + 1, cy, cz) && opaque_uniform(cx - 1, cy, cz) &&
+        opaque_uniform(cx, cy + 1, cz) && opaque_uniform(cx, cy - 1, cz) &&
+        opaque_uniform(cx, cy, cz + 1) && opaque_uniform(cx, cy, cz - 1);
+}
+
+size_t World::allocated_sections() const
+{
+    size_t n = 0;
+    for (const ChunkColumn& col : columns) {
+        for (const ChunkSection& sec : col.sections) {
+            if (sec.hot()) ++n;
+        }
+    }
+    return n;
+}
 
-                const int cx = gx / CHUNK_X;
-                const int cy = gy / CHUNK_Y;
-                const int cz = gz / CHUNK_Z;
+size_t World::packed_sections() const
+{
+    size_t n = 0;
+    for (const ChunkColumn& col : columns) {
+        for (const ChunkSection& sec : col.sections) {
+            if (sec.packed()) ++n;
+        }
+    }
+    return n;
+}
 
-                const int lx = gx % CHUNK_X;
-                const int ly = gy % CHUNK_Y;
-                const int lz = gz % CHUNK_Z;
+ChunkVersion* World::begin_section_edit(int cx, int cy, int cz) const
+{
+    const ChunkSection& sec = section_at(cx, cy, cz);
+    if (const ChunkVersion* cur = sec.chunk()) {
+        return new ChunkVersion(*cur);
+    }
+
+    ChunkVersion* v = new ChunkVersion();
+    v->blocks.fill(static_cast<uint8_t>(sec.fill()));
+    return v;
+}
+
+void World::commit_section_edit(int cx, int cy, int cz, ChunkVersion* edited, bool collapse_uniform)
+{
+    section_at(cx, cy, cz).touched = m_frame;
+
+    if (collapse_uniform) {
+        const auto& b = edited->blocks;
+        if (std::all_of(b.begin(), b.end(), [v = b[0]](uint8_t x) { return x == v; })) {
+            const BlockType t = static_cast<BlockType>(b[0]);
+            delete edited;      // never published, no reader can see it
+            set_section_uniform(cx, cy, cz, t);
+            return;
+        }
+    }
+
+    section_at(cx, cy, cz).publish(edited);
+}
+
+bool World::commit_section_packed(int cx, int cy, int cz, const ChunkVersion* from, const PackedChunk* p)
+{
+    ChunkSection& sec = section_at(cx, cy, cz);
+    if (sec.hot() != from) {
+        packed_chunk_release(p);
+        return false;
+    }
+
+    sec.publish_packed(p);
+    return true;
+}
+
+void World::set_section_uniform(int cx, int cy, int cz, BlockType t)
+{
+    ChunkSection& sec = section_at(cx, cy, cz);
+    sec.touched = m_frame;
+    sec.publish_uniform(t);
+}
+
+void World::update_top_section(int cx, int cz)
+{
+    ChunkColumn& col = column_at(cx, cz);
+    col.top_section = -1;
+    for (int cy = m_chunks_y - 1; cy >= 0; --cy) {
+        if (!col.sections[cy].is_empty()) {
+            col.top_section = cy;
+            break;
+        }
+    }
+}
+
+void World::mark_section_dirty(int cx, int cy, int cz)
+{
+    if (cx < 0 || cx >= WORLD_CHUNKS_X ||
+        cy < 0 || cy >= m_chunks_y ||
+        cz < 0 || cz >= WORLD_CHUNKS_Z) {
+        return;
+    }
+
+    ChunkSection& sec = section_at(cx, cy, cz);
+    if (sec.dirty) return;
+
+    sec.dirty = true;
+    m_dirty.push_back(SectionCoord{ cx, cy, cz });
+}
+
+std::vector<SectionCoord> World::take_dirty_sections()
+{
+    for (const SectionCoord& c : m_dirty) {
+        section_at(c.cx, c.cy, c.cz).dirty = false;
+    }
+
+    std::vector<SectionCoord> out;
+    out.swap(m_dirty);
+    return out;
+}
+
+WorldSnapshot World::snapshot() const
+{
+    WorldSnapshot snap;
+    snap.m_chunks_y = m_chunks_y;
+    snap.m_sections.reserve(columns.size() * static_cast<size_t>(m_chunks_y));
+
+    for (const ChunkColumn& col : columns) {
+        for (const ChunkSection& sec : col.sections) {
+            WorldSnapshot::Entry e;
+            e.chunk = sec.hot();
+            e.packed = sec.packed();
+            e.fill = sec.fill();
+            chunk_version_acquire(e.chunk);
+            packed_chunk_acquire(e.packed);
+            snap.m_sections.push_back(e);
+        }
+    }
+    return snap;
+}
+
+void World::restore(const WorldSnapshot& snap)
+{
+    if (snap.m_chunks_y != m_chunks_y) return;
+
+    size_t i = 0;
+    for (int cz = 0; cz < WORLD_CHUNKS_Z; ++cz) {
+        for (int cx = 0; cx < WORLD_CHUNKS_X; ++cx) {
+            for (int cy = 0; cy < m_chunks_y; ++cy) {
+                const WorldSnapshot::Entry& e = snap.m_sections[i++];
+                ChunkSection& sec = section_at(cx, cy, cz);
+
+                // Unchanged sections still point at the very same version
+                if (sec.hot() == e.chunk && sec.packed() == e.packed &&
+                    (e.chunk || e.packed || sec.fill() == e.fill)) {
+                    continue;
+                }
+
+                sec.touched = m_frame;
+                if (e.chunk) {
+                    chunk_version_acquire(e.chunk);
+                    sec.publish(e.chunk);
+                }
+                else if (e.packed) {
+                    packed_chunk_acquire(e.packed);
+                    sec.publish_packed(e.packed);
+                }
+                else {
+                    sec.publish_uniform(e.fill);
+                }
 
-                chunk_at(cx, cy, cz).set_local(lx, ly, lz, t);
+                // Border faces of the neighbors may change as well
+                mark_section_dirty(cx, cy, cz);
+                mark_section_dirty(cx + 1, cy, cz);
+                mark_section_dirty(cx - 1, cy, cz);
+                mark_section_dirty(cx, cy + 1, cz);
+                mark_section_dirty(cx, cy - 1, cz);
+                mark_section_dirty(cx, cy, cz + 1);
+                mark_section_dirty(cx, cy, cz - 1);
             }
+            update_top_section(cx, cz);
         }
     }
 }
@@ -30,7 +657,7 @@ void World::fill_terrain_noise_10_16_grass_stone()
 BlockType World::get_global(int gx, int gy, int gz) const
 {
     if (gx < 0 || gx >= WORLD_SIZE_X ||
-        gy < 0 || gy >= WORLD_SIZE_Y ||
+        gy < 0 || gy >= size_y() ||
         gz < 0 || gz >= WORLD_SIZE_Z) {
         return BlockType::Air;
     }
@@ -43,5 +670,5 @@ BlockType World::get_global(int gx, int gy, int gz) const
     const int ly = gy % CHUNK_Y;
     const int lz = gz % CHUNK_Z;
 
-    return chunk_at(cx, cy, cz).get_local(lx, ly, lz);
+    return section_at(cx, cy, cz).get_local(lx, ly, lz);
 }
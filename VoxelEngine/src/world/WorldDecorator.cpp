@@ -0,0 +1,241 @@
+#include "world/WorldDecorator.h"
+
+#include <algorithm>
+
+namespace {
+
+constexpr int TREE_ATTEMPTS = 3;        // candidate spots per column
+constexpr int TREE_MIN_TRUNK = 4;
+constexpr int TREE_MAX_TRUNK = 6;
+constexpr int LEAF_RADIUS = 2;
+
+uint64_t mix64(uint64_t h)
+{
+    h ^= h >> 30;
+    h *= 0xBF58476D1CE4E5B9ull;
+    h ^= h >> 27;
+    h *= 0x94D049BB133111EBull;
+    h ^= h >> 31;
+    return h;
+}
+
+uint64_t column_hash(uint32_t seed, int cx, int cz, int i)
+{
+    return mix64((static_cast<uint64_t>(seed) << 32) ^
+        (static_cast<uint64_t>(static_cast<uint32_t>(cx)) * 0x9E3779B97F4A7C15ull) ^
+        (static_cast<uint64_t>(static_cast<uint32_t>(cz)) * 0xC2B2AE3D27D4EB4Full) ^
+        static_cast<uint64_t>(i));
+}
+
+// Merge order of decoration writes: a block is only replaced by a higher
+// rank. Terrain (and anything else) ranks above every decoration block.
+int decoration_rank(BlockType t)
+{
+    switch (t) {
+    case BlockType::Air:    return 0;
+    case BlockType::Leaves: return 1;
+    case BlockType::Wood:   return 2;
+    default:                return 3;
+    }
+}
+
+bool in_world(const World& world, const BlockWrite& w)
+{
+    return w.gx >= 0 && w.gx < WORLD_SIZE_X &&
+        w.gy >= 0 && w.gy < world.size_y() &&
+        w.gz >= 0 && w.gz < WORLD_SIZE_Z;
+}
+
+} // namespace
+
+WorldDecorator::WorldDecorator(World& world, uint32_t seed)
+    : m_world(world), m_seed(seed)
+{
+}
+
+// Top non-air block of block column (lx, lz), -1 if there is none.
+int WorldDecorator::surface_y(int cx, int cz, int lx, int lz) const
+{
+    const ChunkColumn& col = m_world.column_at(cx, cz);
+    for (int cy = col.top_section; cy >= 0; --cy) {
+        const ChunkSection& sec = col.sections[cy];
+        if (sec.is_empty()) continue;
+        for (int ly = CHUNK_Y - 1; ly >= 0; --ly) {
+            if (sec.get_local(lx, ly, lz) != BlockType::Air) return cy * CHUNK_Y + ly;
+        }
+    }
+    return -1;
+}
+
+// Trees stand on grass: a trunk of 4..6 wood and a leaf blob around its top,
+// up to LEAF_RADIUS blocks into the neighbor columns. Reads only this
+// column's terrain, which no other column writes to before it is decorated.
+void WorldDecorator::plan_trees(int cx, int cz, std::vector<BlockWrite>& out)
+{
+    for (int i = 0; i < TREE_ATTEMPTS; ++i) {
+        const uint64_t r = column_hash(m_seed, cx, cz, i);
+        if ((r & 3) == 0) continue;
+
+        const int lx = static_cast<int>((r >> 2) & 15);
+        const int lz = static_cast<int>((r >> 6) & 15);
+        const int trunk = TREE_MIN_TRUNK + static_cast<int>((r >> 10) % (TREE_MAX_TRUNK - TREE_MIN_TRUNK + 1));
+
+        const int ground = surface_y(cx, cz, lx, lz);
+        if (ground < 0) continue;
+        if (m_world.section_at(cx, ground / CHUNK_Y, cz).get_local(lx, ground % CHUNK_Y, lz) != BlockType::Grass) continue;
+        if (ground + trunk + 2 >= m_world.size_y()) continue;
+
+        const int gx = cx * CHUNK_X + lx;
+        const int gz = cz * CHUNK_Z + lz;
+        const int top = ground + trunk;
+
+        for (int gy = ground + 1; gy <= top; ++gy) {
+            out.push_back(BlockWrite{ gx, gy, gz, BlockType::Wood });
+        }
+
+        for (int dy = -2; dy <= 1; ++dy) {
+            const int radius = dy < 0 ? LEAF_RADIUS : 1;
+            for (int dz = -radius; dz <= radius; ++dz) {
+                for (int dx = -radius; dx <= radius; ++dx) {
+                    // Ragged corners, chosen per tree so the shape is fixed by the seed
+                    const bool corner = std::abs(dx) == radius && std::abs(dz) == radius;
+                    if (corner && (dy == 1 || ((r >> (16 + (dx + 2) + 5 * (dz + 2) + (dy + 2))) & 1) == 0)) continue;
+                    out.push_back(BlockWrite{ gx + dx, top + dy, gz + dz, BlockType::Leaves });
+                }
+            }
+        }
+
+        m_structures.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+// Merges writes into column (cx, cz), one copy-on-write edit per touched
+// section. The caller holds the column's lock.
+void WorldDecorator::apply(int cx, int cz, std::vector<BlockWrite>& writes)
+{
+    std::sort(writes.begin(), writes.end(), [](const BlockWrite& a, const BlockWrite& b) { return a.gy < b.gy; });
+
+    const int x0 = cx * CHUNK_X;
+    const int z0 = cz * CHUNK_Z;
+
+    size_t i = 0;
+    while (i < writes.size()) {
+        const int cy = writes[i].gy / CHUNK_Y;
+        const ChunkSection& sec = m_world.section_at(cx, cy, cz);
+        ChunkVersion* edit = nullptr;
+
+        for (; i < writes.size() && writes[i].gy / CHUNK_Y == cy; ++i) {
+            const BlockWrite& w = writes[i];
+            const int lx = w.gx - x0;
+            const int ly = w.gy - cy * CHUNK_Y;
+            const int lz = w.gz - z0;
+
+            const BlockType cur = edit ? edit->get_local(lx, ly, lz) : sec.get_local(lx, ly, lz);
+            if (decoration_rank(w.t) <= decoration_rank(cur)) continue;
+
+            if (!edit) edit = m_world.begin_section_edit(cx, cy, cz);
+            edit->set_local(lx, ly, lz, w.t);
+        }
+
+        if (edit) m_world.commit_section_edit(cx, cy, cz, edit);
+    }
+
+    m_world.update_top_section(cx, cz);
+}
+
+void WorldDecorator::decorate_column(int cx, int cz)
+{
+    std::vector<BlockWrite> writes;
+    plan_trees(cx, cz, writes);
+    m_writes.fetch_add(writes.size(), std::memory_order_relaxed);
+
+    writes.erase(std::remove_if(writes.begin(), writes.end(), [this](const BlockWrite& w) { return !in_world(m_world, w); }),
+        writes.end());
+
+    // Group by target column; this column's own writes go last
+    const int own = World::col_idx(cx, cz);
+    const auto target = [](const BlockWrite& w) { return World::col_idx(w.gx / CHUNK_X, w.gz / CHUNK_Z); };
+    std::sort(writes.begin(), writes.end(), [&](const BlockWrite& a, const BlockWrite& b) {
+        const int ta = target(a) == own ? -1 : target(a);
+        const int tb = target(b) == own ? -1 : target(b);
+        return ta > tb;
+    });
+
+    // One column lock at a time, so jobs never wait on each other in a cycle
+    while (!writes.empty() && target(writes.front()) != own) {
+        const int t = target(writes.front());
+        auto end = std::find_if(writes.begin(), writes.end(), [&](const BlockWrite& w) { return target(w) != t; });
+        std::vector<BlockWrite> batch(writes.begin(), end);
+        writes.erase(writes.begin(), end);
+
+        Column& col = m_columns[static_cast<size_t>(t)];
+        std::lock_guard<std::mutex> lock(col.mutex);
+        if (col.decorated) {
+            m_late.fetch_add(batch.size(), std::memory_order_relaxed);
+            apply(t % WORLD_CHUNKS_X, t / WORLD_CHUNKS_X, batch);
+        }
+        else {
+            m_deferred.fetch_add(batch.size(), std::memory_order_relaxed);
+            col.pending.insert(col.pending.end(), batch.begin(), batch.end());
+        }
+    }
+
+    Column& col = m_columns[static_cast<size_t>(own)];
+    std::lock_guard<std::mutex> lock(col.mutex);
+    writes.insert(writes.end(), col.pending.begin(), col.pending.end());
+    col.pending.clear();
+    col.pending.shrink_to_fit();
+    apply(cx, cz, writes);
+    col.decorated = true;
+}
+
+size_t WorldDecorator::pending_writes()
+{
+    size_t n = 0;
+    for (Column& col : m_columns) {
+        std::lock_guard<std::mutex> lock(col.mutex);
+        n += col.pending.size();
+    }
+    return n;
+}
+
+DecorationStats WorldDecorator::stats() const
+{
+    DecorationStats s;
+    s.structures = m_structures.load(std::memory_order_relaxed);
+    s.writes = m_writes.load(std::memory_order_relaxed);
+    s.deferred = m_deferred.load(std::memory_order_relaxed);
+    s.late = m_late.load(std::memory_order_relaxed);
+    return s;
+}
+
+void generate_decorated_world(World& world, JobPool& pool, const WorldGenSettings& settings,
+    const std::vector<int>& order,
+    TerrainGenStats* terrain_stats,
+    DecorationStats* decoration_stats)
+{
+    constexpr int COLUMNS = WORLD_CHUNKS_X * WORLD_CHUNKS_Z;
+
+    std::vector<int> columns = order;
+    if (columns.empty()) {
+        for (int i = 0; i < COLUMNS; ++i) columns.push_back(i);
+    }
+
+    WorldDecorator decorator(world, settings.seed);
+    std::vector<TerrainGenStats> gen(columns.size());
+
+    pool.parallel_for(static_cast<int>(columns.size()), [&](int i) {
+        const int cx = columns[static_cast<size_t>(i)] % WORLD_CHUNKS_X;
+        const int cz = columns[static_cast<size_t>(i)] / WORLD_CHUNKS_X;
+        TerrainGenStats& stats = gen[static_cast<size_t>(i)];
+        if (settings.caves) world.generate_column_caves(cx, cz, settings.min_height, settings.max_height, settings.noise_stride, stats);
+        else world.generate_column_noise(cx, cz, settings.min_height, settings.max_height, settings.noise_stride, stats);
+        decorator.decorate_column(cx, cz);
+    });
+
+    if (terrain_stats) {
+        *terrain_stats = TerrainGenStats{};
+        for (const TerrainGenStats& s : gen) *terrain_stats += s;
+    }
+    if (decoration_stats) *decoration_stats = decorator.stats();
+}
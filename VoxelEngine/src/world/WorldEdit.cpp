@@ -0,0 +1,295 @@
+#include "world/WorldEdit.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+// Part of an edit inside one section, in that section's local coordinates.
+struct SectionSpan
+{
+    int cx, cy, cz;
+    int x0, y0, z0;
+    int x1, y1, z1;
+
+    bool covers_section() const
+    {
+        return x0 == 0 && y0 == 0 && z0 == 0 &&
+            x1 == CHUNK_X && y1 == CHUNK_Y && z1 == CHUNK_Z;
+    }
+};
+
+BlockBox clip_to_world(const World& world, const BlockBox& b)
+{
+    BlockBox c;
+    c.x0 = std::max(b.x0, 0);
+    c.y0 = std::max(b.y0, 0);
+    c.z0 = std::max(b.z0, 0);
+    c.x1 = std::min(b.x1, WORLD_SIZE_X);
+    c.y1 = std::min(b.y1, world.size_y());
+    c.z1 = std::min(b.z1, WORLD_SIZE_Z);
+    return c;
+}
+
+bool box_empty(const BlockBox& b)
+{
+    return b.x0 >= b.x1 || b.y0 >= b.y1 || b.z0 >= b.z1;
+}
+
+template <typename F>
+void for_each_section_span(const BlockBox& b, F&& f)
+{
+    for (int cz = b.z0 / CHUNK_Z; cz <= (b.z1 - 1) / CHUNK_Z; ++cz) {
+        for (int cx = b.x0 / CHUNK_X; cx <= (b.x1 - 1) / CHUNK_X; ++cx) {
+            for (int cy = b.y0 / CHUNK_Y; cy <= (b.y1 - 1) / CHUNK_Y; ++cy) {
+                SectionSpan s;
+                s.cx = cx;
+                s.cy = cy;
+                s.cz = cz;
+                s.x0 = std::max(b.x0 - cx * CHUNK_X, 0);
+                s.y0 = std::max(b.y0 - cy * CHUNK_Y, 0);
+                s.z0 = std::max(b.z0 - cz * CHUNK_Z, 0);
+                s.x1 = std::min(b.x1 - cx * CHUNK_X, CHUNK_X);
+                s.y1 = std::min(b.y1 - cy * CHUNK_Y, CHUNK_Y);
+                s.z1 = std::min(b.z1 - cz * CHUNK_Z, CHUNK_Z);
+                f(s);
+            }
+        }
+    }
+}
+
+// Marks the section dirty, plus neighbors whose border faces the edit touched.
+void mark_span_dirty(World& world, const SectionSpan& s)
+{
+    world.mark_section_dirty(s.cx, s.cy, s.cz);
+    if (s.x0 == 0)       world.mark_section_dirty(s.cx - 1, s.cy, s.cz);
+    if (s.x1 == CHUNK_X) world.mark_section_dirty(s.cx + 1, s.cy, s.cz);
+    if (s.y0 == 0)       world.mark_section_dirty(s.cx, s.cy - 1, s.cz);
+    if (s.y1 == CHUNK_Y) world.mark_section_dirty(s.cx, s.cy + 1, s.cz);
+    if (s.z0 == 0)       world.mark_section_dirty(s.cx, s.cy, s.cz - 1);
+    if (s.z1 == CHUNK_Z) world.mark_section_dirty(s.cx, s.cy, s.cz + 1);
+}
+
+bool span_contains(const ChunkVersion& c, const SectionSpan& s, BlockType t)
+{
+    for (int z = s.z0; z < s.z1; ++z) {
+        for (int y = s.y0; y < s.y1; ++y) {
+            if (c.row_contains(y, z, s.x0, s.x1, t)) return true;
+        }
+    }
+    return false;
+}
+
+void update_columns(World& world, const BlockBox& b)
+{
+    for (int cz = b.z0 / CHUNK_Z; cz <= (b.z1 - 1) / CHUNK_Z; ++cz) {
+        for (int cx = b.x0 / CHUNK_X; cx <= (b.x1 - 1) / CHUNK_X; ++cx) {
+            world.update_top_section(cx, cz);
+        }
+    }
+}
+
+} // namespace
+
+int fill_box(World& world, const BlockBox& box, BlockType t)
+{
+    const BlockBox b = clip_to_world(world, box);
+    if (box_empty(b)) return 0;
+
+    int touched = 0;
+    for_each_section_span(b, [&](const SectionSpan& s) {
+        const ChunkSection& sec = world.section_at(s.cx, s.cy, s.cz);
+        if (sec.is_uniform() && sec.fill() == t) return;
+
+        if (s.covers_section()) {
+            world.set_section_uniform(s.cx, s.cy, s.cz, t);
+        }
+        else {
+            ChunkVersion* c = world.begin_section_edit(s.cx, s.cy, s.cz);
+            for (int z = s.z0; z < s.z1; ++z) {
+                for (int y = s.y0; y < s.y1; ++y) {
+                    c->fill_row(y, z, s.x0, s.x1, t);
+                }
+            }
+            world.commit_section_edit(s.cx, s.cy, s.cz, c);
+        }
+
+        mark_span_dirty(world, s);
+        ++touched;
+    });
+
+    update_columns(world, b);
+    return touched;
+}
+
+int replace_in_box(World& world, const BlockBox& box, BlockType from, BlockType to)
+{
+    const BlockBox b = clip_to_world(world, box);
+    if (box_empty(b) || from == to) return 0;
+
+    int touched = 0;
+    for_each_section_span(b, [&](const SectionSpan& s) {
+        const ChunkSection& sec = world.section_at(s.cx, s.cy, s.cz);
+
+        if (sec.is_uniform()) {
+            if (sec.fill() != from) return;
+            if (s.covers_section()) {
+                world.set_section_uniform(s.cx, s.cy, s.cz, to);
+                mark_span_dirty(world, s);
+                ++touched;
+                return;
+            }
+        }
+        else if (!span_contains(*sec.chunk(), s, from)) {
+            // Nothing to replace: no copy, no remesh, no tick wake
+            return;
+        }
+
+        ChunkVersion* c = world.begin_section_edit(s.cx, s.cy, s.cz);
+        for (int z = s.z0; z < s.z1; ++z) {
+            for (int y = s.y0; y < s.y1; ++y) {
+                c->replace_row(y, z, s.x0, s.x1, from, to);
+            }
+        }
+        world.commit_section_edit(s.cx, s.cy, s.cz, c, s.covers_section());
+
+        mark_span_dirty(world, s);
+        ++touched;
+    });
+
+    update_columns(world, b);
+    return touched;
+}
+
+int fill_sphere(World& world, float cx, float cy, float cz, float radius, BlockType t)
+{
+    if (radius <= 0.0f) return 0;
+
+    BlockBox bounds;
+    bounds.x0 = static_cast<int>(std::floor(cx - radius));
+    bounds.y0 = static_cast<int>(std::floor(cy - radius));
+    bounds.z0 = static_cast<int>(std::floor(cz - radius));
+    bounds.x1 = static_cast<int>(std::ceil(cx + radius)) + 1;
+    bounds.y1 = static_cast<int>(std::ceil(cy + radius)) + 1;
+    bounds.z1 = static_cast<int>(std::ceil(cz + radius)) + 1;
+
+    const BlockBox b = clip_to_world(world, bounds);
+    if (box_empty(b)) return 0;
+
+    // A voxel is inside when its center is within the radius
+    const float r2 = radius * radius;
+
+    int touched = 0;
+    for_each_section_span(b, [&](const SectionSpan& s) {
+        const int ox = s.cx * CHUNK_X;
+        const int oy = s.cy * CHUNK_Y;
+        const int oz = s.cz * CHUNK_Z;
+
+        const ChunkSection& sec = world.section_at(s.cx, s.cy, s.cz);
+        if (sec.is_uniform() && sec.fill() == t) return;
+
+        // Whole section inside: the farthest voxel center is within the radius
+        if (s.covers_section()) {
+            const float fx = std::max(std::abs(ox + 0.5f - cx), std::abs(ox + CHUNK_X - 0.5f - cx));
+            const float fy = std::max(std::abs(oy + 0.5f - cy), std::abs(oy + CHUNK_Y - 0.5f - cy));
+            const float fz = std::max(std::abs(oz + 0.5f - cz), std::abs(oz + CHUNK_Z - 0.5f - cz));
+            if (fx * fx + fy * fy + fz * fz <= r2) {
+                world.set_section_uniform(s.cx, s.cy, s.cz, t);
+                mark_span_dirty(world, s);
+                ++touched;
+                return;
+            }
+        }
+
+        ChunkVersion* c = nullptr;
+
+        for (int z = s.z0; z < s.z1; ++z) {
+            const float dz = oz + z + 0.5f - cz;
+            for (int y = s.y0; y < s.y1; ++y) {
+                const float dy = oy + y + 0.5f - cy;
+                const float rem = r2 - dy * dy - dz * dz;
+                if (rem < 0.0f) continue;
+
+                const float half = std::sqrt(rem);
+                const int x0 = std::max(static_cast<int>(std::ceil(cx - half - 0.5f)) - ox, s.x0);
+                const int x1 = std::min(static_cast<int>(std::floor(cx + half - 0.5f)) + 1 - ox, s.x1);
+                if (x0 >= x1) continue;
+
+                if (!c) c = world.begin_section_edit(s.cx, s.cy, s.cz);
+                c->fill_row(y, z, x0, x1, t);
+            }
+        }
+
+        if (c) {
+            world.commit_section_edit(s.cx, s.cy, s.cz, c);
+            mark_span_dirty(world, s);
+            ++touched;
+        }
+    });
+
+    update_columns(world, b);
+    return touched;
+}
+
+BlockRegion copy_region(const World& world, const BlockBox& box)
+{
+    BlockRegion r;
+    const BlockBox b = clip_to_world(world, box);
+    if (box_empty(b)) return r;
+
+    r.size_x = b.x1 - b.x0;
+    r.size_y = b.y1 - b.y0;
+    r.size_z = b.z1 - b.z0;
+    r.blocks.assign(static_cast<size_t>(r.size_x) * r.size_y * r.size_z, 0);
+
+    for_each_section_span(b, [&](const SectionSpan& s) {
+        const ChunkSection& sec = world.section_at(s.cx, s.cy, s.cz);
+        const ChunkVersion* c = sec.chunk();
+        const int rx = s.cx * CHUNK_X + s.x0 - b.x0;
+
+        for (int z = s.z0; z < s.z1; ++z) {
+            const int rz = s.cz * CHUNK_Z + z - b.z0;
+            for (int y = s.y0; y < s.y1; ++y) {
+                const int ry = s.cy * CHUNK_Y + y - b.y0;
+                uint8_t* dst = &r.blocks[r.idx(rx, ry, rz)];
+
+                if (c) {
+                    c->read_row(y, z, s.x0, s.x1, dst);
+                }
+                else {
+                    std::fill(dst, dst + (s.x1 - s.x0), static_cast<uint8_t>(sec.fill()));
+                }
+            }
+        }
+    });
+
+    return r;
+}
+
+int paste_region(World& world, const BlockRegion& region, int gx, int gy, int gz, bool skip_air)
+{
+    const BlockBox target{ gx, gy, gz, gx + region.size_x, gy + region.size_y, gz + region.size_z };
+    const BlockBox b = clip_to_world(world, target);
+    if (box_empty(b)) return 0;
+
+    int touched = 0;
+    for_each_section_span(b, [&](const SectionSpan& s) {
+        ChunkVersion* c = world.begin_section_edit(s.cx, s.cy, s.cz);
+        const int rx = s.cx * CHUNK_X + s.x0 - gx;
+
+        for (int z = s.z0; z < s.z1; ++z) {
+            const int rz = s.cz * CHUNK_Z + z - gz;
+            for (int y = s.y0; y < s.y1; ++y) {
+                const int ry = s.cy * CHUNK_Y + y - gy;
+                c->write_row(y, z, s.x0, s.x1, &region.blocks[region.idx(rx, ry, rz)], skip_air);
+            }
+        }
+        world.commit_section_edit(s.cx, s.cy, s.cz, c, s.covers_section());
+
+        mark_span_dirty(world, s);
+        ++touched;
+    });
+
+    update_columns(world, b);
+    return touched;
+}